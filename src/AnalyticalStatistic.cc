@@ -25,14 +25,36 @@ AnalyticalStatistic::AnalyticalStatistic() {
 }
 
 void AnalyticalStatistic::addResult(unsigned long long& analyticalResults) {
+    std::lock_guard<std::mutex> lock(mutex);
     for (int i = 0; i < 22; i++) {
         analyticalResults += executeTPCHSuccessCount[i];
     }
 }
 
-void AnalyticalStatistic::executeTPCHSuccess(int queryNumber, bool success) {
-    if (success)
+void AnalyticalStatistic::executeTPCHSuccess(int queryNumber, bool success,
+                                             uint64_t latencyNanos) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (success) {
         executeTPCHSuccessCount[queryNumber - 1]++;
-    else
+        latencies[queryNumber - 1].record(latencyNanos);
+    } else
         executeTPCHFailCount[queryNumber - 1]++;
 }
+
+void AnalyticalStatistic::addLatencies(LatencyHistogram& allQueries) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < 22; i++) {
+        allQueries += latencies[i];
+    }
+}
+
+void AnalyticalStatistic::addCounts(unsigned long long* succeeded,
+                                    unsigned long long* failed,
+                                    LatencyHistogram* perQuery) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < 22; i++) {
+        succeeded[i] += executeTPCHSuccessCount[i];
+        failed[i] += executeTPCHFailCount[i];
+        perQuery[i] += latencies[i];
+    }
+}
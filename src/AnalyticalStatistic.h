@@ -18,16 +18,30 @@ limitations under the License.
 #ifndef ANALYTICALSTATISTIC_H
 #define ANALYTICALSTATISTIC_H
 
+#include "Histogram.h"
+
+#include <cstdint>
+#include <mutex>
+
 class AnalyticalStatistic {
 
   private:
     unsigned long long executeTPCHSuccessCount[22];
     unsigned long long executeTPCHFailCount[22];
+    LatencyHistogram latencies[22];
+    // held by the thread that counts and by those that read the counts
+    mutable std::mutex mutex;
 
   public:
     AnalyticalStatistic();
     void addResult(unsigned long long& analyticalResults);
-    void executeTPCHSuccess(int queryNumber, bool success);
+    // Counts a query, and records the latency of a successful one.
+    void executeTPCHSuccess(int queryNumber, bool success,
+                            uint64_t latencyNanos);
+    void addLatencies(LatencyHistogram& allQueries) const;
+    // Adds the counts and latencies of every query.
+    void addCounts(unsigned long long* succeeded, unsigned long long* failed,
+                   LatencyHistogram* perQuery) const;
 };
 
 #endif
@@ -0,0 +1,112 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "Chunks.h"
+
+#include "Gzip.h"
+#include "Log.h"
+#include "RowWriter.h"
+
+#include <cstring>
+#include <sys/stat.h>
+#include <unistd.h>
+
+ChunkReader::ChunkReader(const std::string& path, int64_t rowsPerChunk_)
+    : in(gzopen(path.c_str(), "rb")), rowsPerChunk(rowsPerChunk_),
+      buf(new char[RowWriter::bufferSize]) {
+    if (!in) {
+        Log::l2() << Log::tm() << "-opening " << path << " failed\n";
+        return;
+    }
+    gzbuffer(in, 1 << 17);
+}
+
+ChunkReader::~ChunkReader() {
+    if (in)
+        gzclose(in);
+}
+
+bool ChunkReader::fill() {
+    int n = gzread(in, buf.get(), RowWriter::bufferSize);
+    if (n < 0) {
+        failed = true;
+        return false;
+    }
+    pos = 0;
+    len = n;
+    return n > 0;
+}
+
+bool ChunkReader::done() { return ok() && pos == len && !fill(); }
+
+bool ChunkReader::next(const std::function<bool(const char*, size_t)>& out) {
+    if (!ok())
+        return false;
+    for (int64_t rows = 0; rows < rowsPerChunk;) {
+        if (pos == len && !fill())
+            break;
+        const char* start = buf.get() + pos;
+        const char* end = buf.get() + len;
+        const char* p = start;
+        while (rows < rowsPerChunk &&
+               (p = static_cast<const char*>(memchr(p, '\n', end - p)))) {
+            rows++;
+            p++;
+        }
+        if (!p)
+            p = end;
+        if (!out(start, p - start)) {
+            failed = true;
+            break;
+        }
+        pos = p - buf.get();
+    }
+    return ok();
+}
+
+ChunkPipe::ChunkPipe(ChunkReader& reader_, const std::string& fifo_)
+    : reader(reader_), fifo(fifo_) {
+    unlink(fifo.c_str());
+    if (mkfifo(fifo.c_str(), 0644) != 0) {
+        Log::l2() << Log::tm() << "-creating pipe " << fifo << " failed\n";
+        return;
+    }
+    thread = std::thread(&ChunkPipe::feed, this);
+}
+
+ChunkPipe::~ChunkPipe() { finish(); }
+
+void ChunkPipe::feed() {
+    int fd = openPipeWriter(fifo, abandoned);
+    if (fd == -1)
+        return;
+    ok = reader.next([fd](const char* data, size_t len) {
+        return writeAll(fd, data, len);
+    });
+    ::close(fd);
+}
+
+bool ChunkPipe::finish() {
+    if (!thread.joinable())
+        return ok;
+    abandoned = true;
+    thread.join();
+    unlink(fifo.c_str());
+    if (!ok)
+        Log::l2() << Log::tm() << "-passing a chunk through " << fifo
+                  << " failed\n";
+    return ok;
+}
@@ -0,0 +1,77 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <zlib.h>
+
+// Reads a table file, gzip-compressed or not, as consecutive chunks of a
+// fixed number of rows, holding no more than one buffer of it at a time.
+class ChunkReader {
+    gzFile in;
+    int64_t rowsPerChunk;
+    std::unique_ptr<char[]> buf;
+    size_t pos = 0;
+    size_t len = 0;
+    bool failed = false;
+
+    bool fill();
+
+  public:
+    ChunkReader(const std::string& path, int64_t rowsPerChunk);
+    ~ChunkReader();
+    ChunkReader(const ChunkReader&) = delete;
+    ChunkReader& operator=(const ChunkReader&) = delete;
+
+    bool ok() const { return in && !failed; }
+    // Whether all rows have been read.
+    bool done();
+    // Passes the rows of the next chunk to out, in pieces that may split
+    // rows. Returns false if reading the file or out failed.
+    bool next(const std::function<bool(const char*, size_t)>& out);
+    // Reads past the next chunk, e.g. one loaded before a resumed import.
+    bool skip() {
+        return next([](const char*, size_t) { return true; });
+    }
+};
+
+// Passes the next chunk of a ChunkReader through a named pipe, for import
+// statements that read from a path. Like GunzipPipe, the pipe is fed by a
+// background thread once the database opens it.
+class ChunkPipe {
+    ChunkReader& reader;
+    std::string fifo;
+    std::atomic<bool> abandoned{false};
+    bool ok = false;
+    std::thread thread;
+
+    void feed();
+
+  public:
+    ChunkPipe(ChunkReader& reader, const std::string& fifo);
+    ~ChunkPipe();
+    const std::string& path() const { return fifo; }
+    // Waits for the chunk to be drained, or gives up on it if nothing ever
+    // opened the pipe, and removes the pipe. Returns whether the whole chunk
+    // was passed through.
+    bool finish();
+};
@@ -0,0 +1,135 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "Clock.h"
+
+#include <atomic>
+#include <climits>
+#include <ctime>
+
+static std::atomic<bool> simulated{false};
+static std::atomic<int64_t> simulatedTime{0};
+
+namespace {
+
+struct Civil {
+    int64_t year;
+    int month, day, hour, minute, second;
+};
+
+} // namespace
+
+void Clock::simulate(int64_t epochSeconds) {
+    simulatedTime = epochSeconds;
+    simulated = true;
+}
+
+int64_t Clock::now() {
+    if (simulated)
+        return simulatedTime;
+    return time(nullptr);
+}
+
+static int64_t utcOffsetAt(int64_t t) {
+    time_t tt = t;
+    tm timeinfo;
+    localtime_r(&tt, &timeinfo);
+    return timeinfo.tm_gmtoff;
+}
+
+// Returns the local time offset seconds from now, broken down.
+static Civil localTime(int64_t offset) {
+    // UTC offsets of recently used days, if the offset is the same all day.
+    struct Day {
+        int64_t day = INT64_MIN;
+        int64_t utcOffset;
+        bool uniform;
+    };
+    thread_local Day recentDays[64];
+
+    int64_t t = Clock::now() + offset;
+    int64_t utcOffset = 0;
+    if (!simulated) {
+        int64_t day = t >= 0 ? t / 86400 : (t - 86399) / 86400;
+        Day& d = recentDays[day & 63];
+        if (d.day != day) {
+            d.day = day;
+            d.utcOffset = utcOffsetAt(day * 86400);
+            d.uniform = utcOffsetAt(day * 86400 + 86399) == d.utcOffset;
+        }
+        utcOffset = d.uniform ? d.utcOffset : utcOffsetAt(t);
+    }
+
+    int64_t local = t + utcOffset;
+    int64_t days = local / 86400;
+    int64_t secs = local % 86400;
+    if (secs < 0) {
+        secs += 86400;
+        days--;
+    }
+
+    // Civil date of a day number, in the proleptic Gregorian calendar.
+    int64_t z = days + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+
+    Civil c;
+    c.day = doy - (153 * mp + 2) / 5 + 1;
+    c.month = mp < 10 ? mp + 3 : mp - 9;
+    c.year = yoe + era * 400 + (c.month <= 2);
+    c.hour = secs / 3600;
+    c.minute = secs / 60 % 60;
+    c.second = secs % 60;
+    return c;
+}
+
+static char* putDigits(char* p, int64_t v, int width) {
+    for (int i = width - 1; i >= 0; i--) {
+        p[i] = '0' + v % 10;
+        v /= 10;
+    }
+    return p + width;
+}
+
+void Clock::format(int64_t offset, char* out) {
+    Civil c = localTime(offset);
+    char* p = putDigits(out, c.year, 4);
+    *p++ = '-';
+    p = putDigits(p, c.month, 2);
+    *p++ = '-';
+    p = putDigits(p, c.day, 2);
+    *p++ = ' ';
+    p = putDigits(p, c.hour, 2);
+    *p++ = ':';
+    p = putDigits(p, c.minute, 2);
+    *p++ = ':';
+    p = putDigits(p, c.second, 2);
+    *p = '\0';
+}
+
+void Clock::get(int64_t offset, SQL_TIMESTAMP_STRUCT& ts) {
+    Civil c = localTime(offset);
+    ts.year = c.year;
+    ts.month = c.month;
+    ts.day = c.day;
+    ts.hour = c.hour;
+    ts.minute = c.minute;
+    ts.second = c.second;
+    ts.fraction = 0;
+}
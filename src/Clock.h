@@ -0,0 +1,47 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <sql.h>
+#include <sqltypes.h>
+
+// The current time, for the timestamps in generated rows and transactions.
+//
+// Timestamps are converted to local time arithmetically. localtime_r, which
+// serializes on the time zone lock, is only consulted for the UTC offset of
+// a day the calling thread has not seen recently, and for every timestamp
+// on the rare day on which the offset changes.
+//
+// The clock can instead be simulated: frozen at a fixed point in time and
+// read as UTC, which makes generated data independent of when it is
+// generated and never touches the time zone database.
+class Clock {
+  public:
+    // Length of a formatted timestamp, "YYYY-MM-DD HH:MM:SS".
+    static constexpr int timestampLength = 19;
+
+    // Freezes the clock at the given number of seconds since the epoch.
+    static void simulate(int64_t epochSeconds);
+    // Seconds since the epoch.
+    static int64_t now();
+
+    // Writes the local time offset seconds from now to out, which must have
+    // room for timestampLength + 1 chars.
+    static void format(int64_t offset, char* out);
+    static void get(int64_t offset, SQL_TIMESTAMP_STRUCT& ts);
+};
@@ -0,0 +1,380 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "Columnar.h"
+
+#include <algorithm>
+#include <charconv>
+#include <err.h>
+
+static const char magic[8] = {'C', 'H', 'C', 'O', 'L', '0', '0', '1'};
+
+using T = ColumnType;
+
+const std::vector<ColumnSpec>& columnSpecs(Table t) {
+    static const std::vector<ColumnSpec> specs[tableCount] = {
+        // warehouse
+        {{"w_id", T::int32, 0, false},
+         {"w_name", T::string, 0, false},
+         {"w_street_1", T::string, 0, false},
+         {"w_street_2", T::string, 0, false},
+         {"w_city", T::string, 0, false},
+         {"w_state", T::dictionary, 0, false},
+         {"w_zip", T::string, 0, false},
+         {"w_tax", T::decimal, 4, false},
+         {"w_ytd", T::decimal, 2, false}},
+        // district
+        {{"d_id", T::int32, 0, false},
+         {"d_w_id", T::int32, 0, false},
+         {"d_name", T::string, 0, false},
+         {"d_street_1", T::string, 0, false},
+         {"d_street_2", T::string, 0, false},
+         {"d_city", T::string, 0, false},
+         {"d_state", T::dictionary, 0, false},
+         {"d_zip", T::string, 0, false},
+         {"d_tax", T::decimal, 4, false},
+         {"d_ytd", T::decimal, 2, false},
+         {"d_next_o_id", T::int32, 0, false}},
+        // customer
+        {{"c_id", T::int32, 0, false},
+         {"c_d_id", T::int32, 0, false},
+         {"c_w_id", T::int32, 0, false},
+         {"c_first", T::string, 0, false},
+         {"c_middle", T::dictionary, 0, false},
+         {"c_last", T::dictionary, 0, false},
+         {"c_street_1", T::string, 0, false},
+         {"c_street_2", T::string, 0, false},
+         {"c_city", T::string, 0, false},
+         {"c_state", T::dictionary, 0, false},
+         {"c_zip", T::string, 0, false},
+         {"c_phone", T::string, 0, false},
+         {"c_since", T::timestamp, 0, false},
+         {"c_credit", T::dictionary, 0, false},
+         {"c_credit_lim", T::decimal, 2, false},
+         {"c_discount", T::decimal, 4, false},
+         {"c_balance", T::decimal, 2, false},
+         {"c_ytd_payment", T::decimal, 2, false},
+         {"c_payment_cnt", T::int32, 0, false},
+         {"c_delivery_cnt", T::int32, 0, false},
+         {"c_data", T::string, 0, false},
+         {"c_n_nationkey", T::int32, 0, false}},
+        // history
+        {{"h_c_id", T::int32, 0, false},
+         {"h_c_d_id", T::int32, 0, false},
+         {"h_c_w_id", T::int32, 0, false},
+         {"h_d_id", T::int32, 0, false},
+         {"h_w_id", T::int32, 0, false},
+         {"h_date", T::timestamp, 0, false},
+         {"h_amount", T::decimal, 2, false},
+         {"h_data", T::string, 0, false}},
+        // neworder
+        {{"no_o_id", T::int32, 0, false},
+         {"no_d_id", T::int32, 0, false},
+         {"no_w_id", T::int32, 0, false}},
+        // order
+        {{"o_id", T::int32, 0, false},
+         {"o_d_id", T::int32, 0, false},
+         {"o_w_id", T::int32, 0, false},
+         {"o_c_id", T::int32, 0, false},
+         {"o_entry_d", T::timestamp, 0, false},
+         {"o_carrier_id", T::int32, 0, true},
+         {"o_ol_cnt", T::int32, 0, false},
+         {"o_all_local", T::int32, 0, false}},
+        // orderline
+        {{"ol_o_id", T::int32, 0, false},
+         {"ol_d_id", T::int32, 0, false},
+         {"ol_w_id", T::int32, 0, false},
+         {"ol_number", T::int32, 0, false},
+         {"ol_i_id", T::int32, 0, false},
+         {"ol_supply_w_id", T::int32, 0, false},
+         {"ol_delivery_d", T::timestamp, 0, true},
+         {"ol_quantity", T::int32, 0, false},
+         {"ol_amount", T::decimal, 2, false},
+         {"ol_dist_info", T::string, 0, false}},
+        // item
+        {{"i_id", T::int32, 0, false},
+         {"i_im_id", T::int32, 0, false},
+         {"i_name", T::string, 0, false},
+         {"i_price", T::decimal, 2, false},
+         {"i_data", T::string, 0, false}},
+        // stock
+        {{"s_i_id", T::int32, 0, false},
+         {"s_w_id", T::int32, 0, false},
+         {"s_quantity", T::int32, 0, false},
+         {"s_dist_01", T::string, 0, false},
+         {"s_dist_02", T::string, 0, false},
+         {"s_dist_03", T::string, 0, false},
+         {"s_dist_04", T::string, 0, false},
+         {"s_dist_05", T::string, 0, false},
+         {"s_dist_06", T::string, 0, false},
+         {"s_dist_07", T::string, 0, false},
+         {"s_dist_08", T::string, 0, false},
+         {"s_dist_09", T::string, 0, false},
+         {"s_dist_10", T::string, 0, false},
+         {"s_ytd", T::int32, 0, false},
+         {"s_order_cnt", T::int32, 0, false},
+         {"s_remote_cnt", T::int32, 0, false},
+         {"s_data", T::string, 0, false},
+         {"s_su_suppkey", T::int32, 0, false}},
+        // nation
+        {{"n_nationkey", T::int32, 0, false},
+         {"n_name", T::string, 0, false},
+         {"n_regionkey", T::int32, 0, false},
+         {"n_comment", T::string, 0, false}},
+        // supplier
+        {{"su_suppkey", T::int32, 0, false},
+         {"su_name", T::string, 0, false},
+         {"su_address", T::string, 0, false},
+         {"su_nationkey", T::int32, 0, false},
+         {"su_phone", T::string, 0, false},
+         {"su_acctbal", T::decimal, 2, false},
+         {"su_comment", T::string, 0, false}},
+        // region
+        {{"r_regionkey", T::int32, 0, false},
+         {"r_name", T::string, 0, false},
+         {"r_comment", T::string, 0, false}}};
+    return specs[static_cast<int>(t)];
+}
+
+// Index of the warehouse id column that row groups are split on, or -1 for
+// the fixed-size tables.
+static int warehouseColumn(Table t) {
+    switch (t) {
+    case Table::warehouse:
+        return 0;
+    case Table::district:
+    case Table::stock:
+        return 1;
+    case Table::customer:
+    case Table::neworder:
+    case Table::order:
+    case Table::orderline:
+        return 2;
+    case Table::history:
+        return 4;
+    default:
+        return -1;
+    }
+}
+
+static bool parseInt(const char* field, size_t len, int64_t& v) {
+    auto res = std::from_chars(field, field + len, v);
+    return res.ec == std::errc() && res.ptr == field + len;
+}
+
+// Parses a decimal such as "-12.34" into its value times 10^scale.
+static bool parseDecimal(const char* field, size_t len, int scale,
+                         int64_t& v) {
+    const char* end = field + len;
+    const char* dot = std::find(field, end, '.');
+    bool negative = len > 0 && *field == '-';
+    int64_t whole;
+    if (!parseInt(field, dot - field, whole))
+        return false;
+    int64_t fraction = 0;
+    int digits = 0;
+    for (const char* p = dot + (dot != end); p < end; p++, digits++) {
+        if (*p < '0' || *p > '9' || digits == scale)
+            return false;
+        fraction = fraction * 10 + (*p - '0');
+    }
+    for (; digits < scale; digits++)
+        fraction *= 10;
+    v = whole;
+    for (int i = 0; i < scale; i++)
+        v *= 10;
+    v += negative ? -fraction : fraction;
+    return true;
+}
+
+// Parses "YYYY-MM-DD HH:MM:SS" into seconds since the epoch, taking the time
+// as it is rather than converting it from local time.
+static bool parseTimestamp(const char* field, size_t len, int64_t& v) {
+    int64_t y, m, d, hh, mm, ss;
+    if (len != 19 || field[4] != '-' || field[7] != '-' || field[10] != ' ' ||
+        field[13] != ':' || field[16] != ':' || !parseInt(field, 4, y) ||
+        !parseInt(field + 5, 2, m) || !parseInt(field + 8, 2, d) ||
+        !parseInt(field + 11, 2, hh) || !parseInt(field + 14, 2, mm) ||
+        !parseInt(field + 17, 2, ss))
+        return false;
+    // Days from 1970-01-01 to y-m-d in the proleptic Gregorian calendar.
+    y -= m <= 2;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yoe = y - era * 400;
+    int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int64_t days = era * 146097 + doe - 719468;
+    v = days * 86400 + hh * 3600 + mm * 60 + ss;
+    return true;
+}
+
+ColumnarSink::ColumnarSink(const std::string& path, Table t)
+    : table(t), specs(columnSpecs(t)), groupColumn(warehouseColumn(t)),
+      file(path), columns(specs.size()) {
+    put(magic, sizeof(magic));
+    uint32_t count = specs.size();
+    put(&count, sizeof(count));
+    for (const auto& spec : specs) {
+        uint8_t header[4] = {static_cast<uint8_t>(spec.type), spec.scale,
+                             spec.nullable,
+                             static_cast<uint8_t>(strlen(spec.name))};
+        put(header, sizeof(header));
+        put(spec.name, header[3]);
+    }
+    out.resize((out.size() + 7) & ~size_t(7));
+}
+
+void ColumnarSink::put(const void* data, size_t len) {
+    auto p = static_cast<const char*>(data);
+    out.insert(out.end(), p, p + len);
+}
+
+void ColumnarSink::putBuffer(const void* data, size_t len) {
+    uint64_t n = len;
+    put(&n, sizeof(n));
+    put(data, len);
+    out.resize((out.size() + 7) & ~size_t(7));
+}
+
+void ColumnarSink::flush() {
+    file.write(out.data(), out.size());
+    fileOffset += out.size();
+    out.clear();
+}
+
+template <typename V>
+static void appendValue(std::vector<char>& values, V v) {
+    auto p = reinterpret_cast<const char*>(&v);
+    values.insert(values.end(), p, p + sizeof(v));
+}
+
+void ColumnarSink::append(Column& column, const ColumnSpec& spec,
+                          const char* field, size_t len) {
+    bool valid = len > 0 || spec.type == T::string;
+    if (spec.nullable) {
+        if (rows % 8 == 0)
+            column.validity.push_back(0);
+        column.validity.back() |= valid << (rows % 8);
+    } else if (!valid) {
+        errx(1, "%s.%s is empty", tableName(table), spec.name);
+    }
+
+    int64_t v = 0;
+    bool ok = true;
+    switch (spec.type) {
+    case T::int32:
+        ok = !valid || parseInt(field, len, v);
+        appendValue(column.values, static_cast<int32_t>(v));
+        break;
+    case T::decimal:
+        ok = !valid || parseDecimal(field, len, spec.scale, v);
+        appendValue(column.values, v);
+        break;
+    case T::timestamp:
+        ok = !valid || parseTimestamp(field, len, v);
+        appendValue(column.values, v);
+        break;
+    case T::string:
+        if (column.offsets.empty())
+            column.offsets.push_back(0);
+        column.data.append(field, len);
+        column.offsets.push_back(column.data.size());
+        break;
+    case T::dictionary: {
+        auto inserted = column.dictionary.emplace(std::string(field, len),
+                                                  column.dictionary.size());
+        if (inserted.second) {
+            if (column.offsets.empty())
+                column.offsets.push_back(0);
+            column.data.append(field, len);
+            column.offsets.push_back(column.data.size());
+        }
+        appendValue(column.values, inserted.first->second);
+        break;
+    }
+    }
+    if (!ok) {
+        errx(1, "invalid value '%.*s' for %s.%s", (int) len, field,
+             tableName(table), spec.name);
+    }
+}
+
+void ColumnarSink::writeRowGroup() {
+    if (rows == 0)
+        return;
+    rowGroupOffsets.push_back(fileOffset + out.size());
+    put(&rows, sizeof(rows));
+    for (size_t c = 0; c < columns.size(); c++) {
+        auto& column = columns[c];
+        if (specs[c].nullable)
+            putBuffer(column.validity.data(), column.validity.size());
+        if (specs[c].type != T::string)
+            putBuffer(column.values.data(), column.values.size());
+        if (specs[c].type == T::string || specs[c].type == T::dictionary) {
+            if (column.offsets.empty())
+                column.offsets.push_back(0);
+            putBuffer(column.offsets.data(),
+                      column.offsets.size() * sizeof(int32_t));
+            putBuffer(column.data.data(), column.data.size());
+        }
+        column = Column();
+    }
+    rows = 0;
+    flush();
+}
+
+void ColumnarSink::write(const char* data, size_t len) {
+    const char* p = data;
+    const char* end = data + len;
+    std::vector<std::pair<const char*, size_t>> fields(columns.size());
+    while (p < end) {
+        for (size_t c = 0; c < fields.size(); c++) {
+            const char* field = p;
+            while (p < end && *p != '|' && *p != '\n')
+                p++;
+            bool last = c == fields.size() - 1;
+            if (p == end || (*p == '\n') != last) {
+                errx(1, "row of %s does not have %zu columns",
+                     tableName(table), fields.size());
+            }
+            fields[c] = {field, p - field};
+            p++;
+        }
+
+        if (groupColumn >= 0) {
+            int64_t key = 0;
+            parseInt(fields[groupColumn].first, fields[groupColumn].second,
+                     key);
+            if (rows > 0 && key != groupKey)
+                writeRowGroup();
+            groupKey = key;
+        }
+        for (size_t c = 0; c < fields.size(); c++)
+            append(columns[c], specs[c], fields[c].first, fields[c].second);
+        rows++;
+    }
+}
+
+void ColumnarSink::close() {
+    writeRowGroup();
+    for (auto offset : rowGroupOffsets)
+        put(&offset, sizeof(offset));
+    uint64_t count = rowGroupOffsets.size();
+    put(&count, sizeof(count));
+    put(magic, sizeof(magic));
+    flush();
+    file.close();
+}
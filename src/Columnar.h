@@ -0,0 +1,111 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include "RowWriter.h"
+#include "Tables.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Extension of the columnar file that gen --format=columnar writes per table,
+// e.g. "stock.col" or, for shard 3, "stock.col.03".
+constexpr const char* columnarExtension = ".col";
+
+// Typed columnar encoding of the generated tables.
+//
+// The per-column buffers use the memory layouts of Apache Arrow, so a reader
+// can hand them to Arrow, or copy them into Parquet pages, without parsing
+// or re-encoding any values. All integers are little-endian.
+//
+//   file     := magic schema rowGroup* footer
+//   magic    := "CHCOL001"
+//   schema   := u32 columnCount, column*, zero padding to a multiple of 8
+//   column   := u8 type, u8 scale, u8 nullable, u8 nameLength, name
+//   rowGroup := u64 rowCount, then the buffers of each column in order
+//   buffer   := u64 byteLength, bytes, zero padding to a multiple of 8
+//   footer   := u64 rowGroupOffset*, u64 rowGroupCount, magic
+//
+// The buffers of a column are:
+//   - if nullable, a validity bitmap in which bit i (LSB first) is set if
+//     row i is not null
+//   - int32: the values
+//   - decimal: the values as int64, multiplied by 10^scale
+//   - timestamp: int64 seconds since 1970-01-01 00:00:00, without time zone
+//   - string: rowCount + 1 int32 offsets into a buffer of UTF-8 data
+//   - dictionary: int32 indices, then the dictionary's offsets and data
+//     buffers as for string. Dictionaries are local to their row group.
+//
+// Tables that scale with the number of warehouses get one row group per
+// warehouse; ITEM, NATION, SUPPLIER and REGION are a single row group.
+enum class ColumnType : uint8_t {
+    int32,
+    decimal,
+    timestamp,
+    string,
+    dictionary,
+};
+
+struct ColumnSpec {
+    const char* name;
+    ColumnType type;
+    uint8_t scale;
+    bool nullable;
+};
+
+const std::vector<ColumnSpec>& columnSpecs(Table t);
+
+// A RowSink that converts the pipe-delimited rows of one table into the
+// columnar format above. Rows are parsed back rather than generated in typed
+// form, so the columnar data is exactly what the text output would contain.
+class ColumnarSink : public RowSink {
+    struct Column {
+        std::vector<uint8_t> validity;
+        std::vector<char> values;
+        std::vector<int32_t> offsets;
+        std::string data;
+        std::unordered_map<std::string, int32_t> dictionary;
+    };
+
+    Table table;
+    const std::vector<ColumnSpec>& specs;
+    int groupColumn;
+    FileSink file;
+    // Encoded bytes not yet written to the file, and the file offset at
+    // which they start.
+    std::vector<char> out;
+    uint64_t fileOffset = 0;
+    std::vector<uint64_t> rowGroupOffsets;
+
+    std::vector<Column> columns;
+    uint64_t rows = 0;
+    int64_t groupKey = 0;
+
+    void put(const void* data, size_t len);
+    void putBuffer(const void* data, size_t len);
+    void append(Column& column, const ColumnSpec& spec, const char* field,
+                size_t len);
+    void writeRowGroup();
+    void flush();
+
+  public:
+    ColumnarSink(const std::string& path, Table table);
+    void write(const char* data, size_t len) override;
+    void close() override;
+};
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "MySqlDialect.h"
 #include "HanaDialect.h"
+#include "PostgresDialect.h"
 #include "Random.h"
 #include "Config.h"
 #include "mz-config.h"
@@ -47,6 +48,70 @@ static chRandom::int_distribution get_int_dist(libconfig::Setting& setting) {
     return chRandom::int_distribution {dist};
 }
 
+// An int or float setting as a double.
+static double get_number(const libconfig::Setting& setting) {
+    switch (setting.getType()) {
+    case libconfig::Setting::TypeInt:
+        return (int)setting;
+    case libconfig::Setting::TypeInt64:
+        return (long long)setting;
+    default:
+        return setting;
+    }
+}
+
+static mz::Phase get_phase(const libconfig::Setting& setting, size_t index) {
+    mz::Phase phase;
+    phase.name = setting.exists("name") ? (std::string)setting["name"]
+                                        : "phase " + std::to_string(index + 1);
+    // the name is written into the JSON report as it is
+    for (char c : phase.name) {
+        if (c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20)
+            throw Config::InvalidPhaseException {phase.name, "name cannot contain quotes, backslashes or control characters"};
+    }
+    if (!setting.exists("seconds") || (int)setting["seconds"] <= 0) {
+        throw Config::InvalidPhaseException {phase.name, "seconds must be positive"};
+    }
+    phase.seconds = setting["seconds"];
+    if (setting.exists("transactional_threads")) {
+        phase.transactionalThreads = (int)setting["transactional_threads"];
+        if (*phase.transactionalThreads < 0)
+            throw Config::InvalidPhaseException {phase.name, "transactional_threads cannot be negative"};
+    }
+    if (setting.exists("analytic_threads")) {
+        phase.analyticThreads = (int)setting["analytic_threads"];
+        if (*phase.analyticThreads < 0)
+            throw Config::InvalidPhaseException {phase.name, "analytic_threads cannot be negative"};
+    }
+    if (setting.exists("target_tpm")) {
+        phase.targetTpm = get_number(setting["target_tpm"]);
+        if (*phase.targetTpm <= 0)
+            throw Config::InvalidPhaseException {phase.name, "target_tpm must be positive"};
+    }
+    if (setting.exists("target_qph")) {
+        phase.targetQph = get_number(setting["target_qph"]);
+        if (*phase.targetQph <= 0)
+            throw Config::InvalidPhaseException {phase.name, "target_qph must be positive"};
+    }
+    if (setting.exists("mix")) {
+        const libconfig::Setting& weights = setting["mix"];
+        std::array<int, 5> mix;
+        int total = 0;
+        if (weights.getLength() != 5)
+            throw Config::InvalidPhaseException {phase.name, "mix must have five weights"};
+        for (int i = 0; i < 5; i++) {
+            mix[i] = weights[i];
+            if (mix[i] < 0)
+                throw Config::InvalidPhaseException {phase.name, "mix weights cannot be negative"};
+            total += mix[i];
+        }
+        if (total == 0)
+            throw Config::InvalidPhaseException {phase.name, "mix weights cannot all be zero"};
+        phase.mix = mix;
+    }
+    return phase;
+}
+
 mz::Config Config::get_config(libconfig::Config &config) {
     using libconfig::Setting;
     mz::Config ret = mz::defaultConfig();
@@ -56,6 +121,8 @@ mz::Config Config::get_config(libconfig::Config &config) {
             ret.dialect = new MySqlDialect();
         } else if (dialect == "hana") {
             ret.dialect = new HanaDialect();
+        } else if (dialect == "postgres") {
+            ret.dialect = new PostgresDialect();
         } else {
             throw Config::UnrecognizedDialectException {dialect};
         }
@@ -96,6 +163,12 @@ mz::Config Config::get_config(libconfig::Config &config) {
     if (config.exists("item_price")) {
         ret.item_price_cents = get_int_dist(config.lookup("item_price"));
     }
+    if (config.exists("phases")) {
+        const Setting& phases = config.lookup("phases");
+        for (int i = 0; i < phases.getLength(); i++) {
+            ret.phases.push_back(get_phase(phases[i], i));
+        }
+    }
     return ret;
 }
 
@@ -114,3 +187,9 @@ const char* Config::UnrecognizedDialectException::what() const noexcept {
 Config::UnrecognizedDialectException::UnrecognizedDialectException(const std::string &dialect) :
  what_rendered { "Unrecognized dialect: " + dialect } {}
 
+const char* Config::InvalidPhaseException::what() const noexcept {
+    return what_rendered.c_str();
+}
+
+Config::InvalidPhaseException::InvalidPhaseException(const std::string &phase, const std::string &problem) :
+ what_rendered { "Invalid phase " + phase + ": " + problem } {}
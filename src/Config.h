@@ -43,5 +43,13 @@ public:
     explicit UnrecognizedDistributionException(const std::string &distribution);
 };
 
+class InvalidPhaseException : public ConfigException {
+    std::string what_rendered;
+public:
+    const char *what() const noexcept override;
+
+    InvalidPhaseException(const std::string &phase, const std::string &problem);
+};
+
 mz::Config get_config(libconfig::Config& config);
 }
@@ -19,11 +19,10 @@ limitations under the License.
 
 #include "Defines.h"
 #include "Random.h"
+#include "Tables.h"
 
+#include <cmath>
 #include <cstdlib>
-#include <ctime>
-#include <iomanip>
-#include <sstream>
 #include <assert.h>
 
 const Nation DataSource::nations[] = {
@@ -183,100 +182,150 @@ const std::vector<const char*> DataSource::tpchAuxiliaries = {"do",
 
 int DataSource::warehouseCount = 0;
 
-std::string DataSource::tpchText(int length) {
-    std::string s;
-    for (int i = 0; i < 25; i++)
-        s += (i == 0 ? "" : " ") + tpchSentence();
-    int pos = chRandom::uniformInt(0, s.length() - length);
-    return s.substr(pos, length);
+// Size of the pool that TPC-H comments are sliced from. Like dbgen, we
+// generate the grammar's sentences once and take every comment as a random
+// substring of the pool, rather than generating fresh sentences per comment.
+static constexpr size_t textPoolSize = 10 * 1024 * 1024;
+
+static const char* pick(const std::vector<const char*>& words) {
+    return words[chRandom::uniformInt(0, words.size() - 1)];
+}
+
+const std::string& DataSource::textPool() {
+    static const std::string pool = [] {
+        // The pool has its own stream, after the tables' ones. The pool may
+        // be built in the middle of generating a row, so put that row's
+        // stream back afterwards.
+        auto saved = chRandom::rng;
+        chRandom::seek(tableCount, 0, 0);
+        std::string s;
+        s.reserve(textPoolSize + 1024);
+        while (s.size() < textPoolSize) {
+            if (!s.empty())
+                s += ' ';
+            appendSentence(s);
+        }
+        s.resize(textPoolSize);
+        chRandom::rng = saved;
+        return s;
+    }();
+    return pool;
+}
+
+void DataSource::addText(int length, RowWriter& stream) {
+    const std::string& pool = textPool();
+    int pos = chRandom::uniformInt(0, pool.size() - length);
+    stream.put(pool.data() + pos, length);
 }
 
-std::string DataSource::tpchSentence() {
-    if (randomTrue(1 / 5))
-        return tpchNounPhrase() + " " + tpchVerbPhrase() + " " +
-               tpchTerminators[chRandom::uniformInt(0, tpchTerminators.size() -
-                                                           1)];
-    else if (randomTrue(1 / 5))
-        return tpchNounPhrase() + " " + tpchVerbPhrase() + " " +
-               tpchPrepositionalPhrase() + " " +
-               tpchTerminators[chRandom::uniformInt(0, tpchTerminators.size() -
-                                                           1)];
-    else if (randomTrue(1 / 5))
-        return tpchNounPhrase() + " " + tpchVerbPhrase() + " " +
-               tpchNounPhrase() + " " +
-               tpchTerminators[chRandom::uniformInt(0, tpchTerminators.size() -
-                                                           1)];
-    else if (randomTrue(1 / 5))
-        return tpchNounPhrase() + " " + tpchPrepositionalPhrase() + " " +
-               tpchVerbPhrase() + " " + tpchNounPhrase() + " " +
-               tpchTerminators[chRandom::uniformInt(0, tpchTerminators.size() -
-                                                           1)];
-    else
-        return tpchNounPhrase() + " " + tpchPrepositionalPhrase() + " " +
-               tpchVerbPhrase() + " " + tpchPrepositionalPhrase() + " " +
-               tpchTerminators[chRandom::uniformInt(0, tpchTerminators.size() -
-                                                           1)];
+void DataSource::appendSentence(std::string& s) {
+    switch (chRandom::uniformInt(0, 4)) {
+    case 0:
+        appendNounPhrase(s);
+        s += ' ';
+        appendVerbPhrase(s);
+        break;
+    case 1:
+        appendNounPhrase(s);
+        s += ' ';
+        appendVerbPhrase(s);
+        s += ' ';
+        appendPrepositionalPhrase(s);
+        break;
+    case 2:
+        appendNounPhrase(s);
+        s += ' ';
+        appendVerbPhrase(s);
+        s += ' ';
+        appendNounPhrase(s);
+        break;
+    case 3:
+        appendNounPhrase(s);
+        s += ' ';
+        appendPrepositionalPhrase(s);
+        s += ' ';
+        appendVerbPhrase(s);
+        s += ' ';
+        appendNounPhrase(s);
+        break;
+    default:
+        appendNounPhrase(s);
+        s += ' ';
+        appendPrepositionalPhrase(s);
+        s += ' ';
+        appendVerbPhrase(s);
+        s += ' ';
+        appendPrepositionalPhrase(s);
+        break;
+    }
+    s += ' ';
+    s += pick(tpchTerminators);
 }
 
-std::string DataSource::tpchNounPhrase() {
-    if (randomTrue(1 / 4))
-        return std::string(
-            tpchNouns[chRandom::uniformInt(0, tpchNouns.size() - 1)]);
-    else if (randomTrue(1 / 4))
-        return std::string(tpchAdjectives[chRandom::uniformInt(
-                   0, tpchAdjectives.size() - 1)]) +
-               " " + tpchNouns[chRandom::uniformInt(0, tpchNouns.size() - 1)];
-    else if (randomTrue(1 / 4))
-        return std::string(tpchAdjectives[chRandom::uniformInt(
-                   0, tpchAdjectives.size() - 1)]) +
-               ", " +
-               tpchAdjectives[chRandom::uniformInt(0,
-                                                   tpchAdjectives.size() - 1)] +
-               " " + tpchNouns[chRandom::uniformInt(0, tpchNouns.size() - 1)];
-    else
-        return std::string(tpchAdverbs[chRandom::uniformInt(
-                   0, tpchAdverbs.size() - 1)]) +
-               " " +
-               tpchAdjectives[chRandom::uniformInt(0,
-                                                   tpchAdjectives.size() - 1)] +
-               " " + tpchNouns[chRandom::uniformInt(0, tpchNouns.size() - 1)];
+void DataSource::appendNounPhrase(std::string& s) {
+    switch (chRandom::uniformInt(0, 3)) {
+    case 0:
+        break;
+    case 1:
+        s += pick(tpchAdjectives);
+        s += ' ';
+        break;
+    case 2:
+        s += pick(tpchAdjectives);
+        s += ", ";
+        s += pick(tpchAdjectives);
+        s += ' ';
+        break;
+    default:
+        s += pick(tpchAdverbs);
+        s += ' ';
+        s += pick(tpchAdjectives);
+        s += ' ';
+        break;
+    }
+    s += pick(tpchNouns);
 }
 
-std::string DataSource::tpchVerbPhrase() {
-    if (randomTrue(1 / 4))
-        return std::string(
-            tpchVerbs[chRandom::uniformInt(0, tpchVerbs.size() - 1)]);
-    else if (randomTrue(1 / 4))
-        return std::string(tpchAuxiliaries[chRandom::uniformInt(
-                   0, tpchAuxiliaries.size() - 1)]) +
-               " " + tpchVerbs[chRandom::uniformInt(0, tpchVerbs.size() - 1)];
-    else if (randomTrue(1 / 4))
-        return std::string(
-                   tpchVerbs[chRandom::uniformInt(0, tpchVerbs.size() - 1)]) +
-               " " +
-               tpchAdverbs[chRandom::uniformInt(0, tpchAdverbs.size() - 1)];
-    else
-        return std::string(tpchAuxiliaries[chRandom::uniformInt(
-                   0, tpchAuxiliaries.size() - 1)]) +
-               " " + tpchVerbs[chRandom::uniformInt(0, tpchVerbs.size() - 1)] +
-               " " +
-               tpchAdverbs[chRandom::uniformInt(0, tpchAdverbs.size() - 1)];
+void DataSource::appendVerbPhrase(std::string& s) {
+    switch (chRandom::uniformInt(0, 3)) {
+    case 0:
+        s += pick(tpchVerbs);
+        break;
+    case 1:
+        s += pick(tpchAuxiliaries);
+        s += ' ';
+        s += pick(tpchVerbs);
+        break;
+    case 2:
+        s += pick(tpchVerbs);
+        s += ' ';
+        s += pick(tpchAdverbs);
+        break;
+    default:
+        s += pick(tpchAuxiliaries);
+        s += ' ';
+        s += pick(tpchVerbs);
+        s += ' ';
+        s += pick(tpchAdverbs);
+        break;
+    }
 }
 
-std::string DataSource::tpchPrepositionalPhrase() {
-    return std::string(tpchPrepositions[chRandom::uniformInt(
-               0, tpchPrepositions.size() - 1)]) +
-           " the " + tpchNounPhrase();
+void DataSource::appendPrepositionalPhrase(std::string& s) {
+    s += pick(tpchPrepositions);
+    s += " the ";
+    appendNounPhrase(s);
 }
 
 void DataSource::initialize(int wc) {
-    srand(1382350201);
     warehouseCount = wc;
 }
 
 bool DataSource::randomTrue(double probability) {
-    double value = rand() / double(RAND_MAX);
-    return value < probability;
+    // Draw from the thread-local generator rather than rand(), whose hidden
+    // lock serializes concurrent gen jobs.
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    return dist(chRandom::rng) < probability;
 }
 
 int DataSource::permute(int value, int low, int high) {
@@ -284,21 +333,6 @@ int DataSource::permute(int value, int low, int high) {
     return ((value * 9973) % range) + low;
 }
 
-void DataSource::getCurrentTimestamp(SQL_TIMESTAMP_STRUCT& ret, int64_t offset) {
-    time_t rawtime;
-    time(&rawtime);
-    rawtime += offset;
-    tm* timeinfo = localtime(&rawtime);
-
-    ret.year = timeinfo->tm_year + 1900;
-    ret.month = timeinfo->tm_mon + 1;
-    ret.day = timeinfo->tm_mday;
-    ret.hour = timeinfo->tm_hour;
-    ret.minute = timeinfo->tm_min;
-    ret.second = timeinfo->tm_sec;
-    ret.fraction = 0;
-}
-
 void DataSource::genCLast(int value, std::string& ret) {
     ret = "";
     ret += cLastParts[value / 100];
@@ -323,159 +357,160 @@ void DataSource::getRemoteWId(int& currentWId, int& ret) {
     }
 }
 
-void DataSource::addNumeric(int length, std::ofstream& stream, bool delimiter) {
-    std::string s;
+void DataSource::addNumeric(int length, RowWriter& stream, bool delimiter) {
+    char* p = stream.reserve(length);
     for (int i = 0; i < length; i++) {
-        s += (char)chRandom::uniformInt('0', '9');
+        p[i] = '0' + chRandom::uniformInt(0, 9);
     }
-    stream << s;
+    stream.commit(length);
     if (delimiter)
-        stream << csvDelim;
+        stream.delimiter();
 }
 
-void DataSource::addAlphanumeric62(int length, std::ofstream& stream,
+// [0-9A-Za-z]
+static const char alphanumeric62[] =
+    "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+// [0-9?@A-Za-z]
+static const char alphanumeric64[] =
+    "0123456789?@ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+void DataSource::addAlphanumeric62(int length, RowWriter& stream,
                                    bool delimiter) {
-    std::string s;
-    int rand;
+    char* p = stream.reserve(length);
     for (int i = 0; i < length; i++) {
-        rand = 0;
-        while (rand == 0 || (rand > '9' && rand < 'A') ||
-               (rand > 'Z' && rand < 'a'))
-            rand = chRandom::uniformInt('0', 'z');
-        s += (char)rand;
+        p[i] = alphanumeric62[chRandom::uniformInt(0, 61)];
     }
-    stream << s;
+    stream.commit(length);
     if (delimiter)
-        stream << csvDelim;
+        stream.delimiter();
 }
 
-void DataSource::addAlphanumeric64(int length, std::ofstream& stream,
+void DataSource::addAlphanumeric64(int length, RowWriter& stream,
                                    bool delimiter) {
-    std::string s;
-    int rand;
-    for (int i = 0; i < length; i++) {
-        rand = 0;
-        while (rand == 0 || (rand > '9' && rand < 63) ||
-               (rand > 'Z' && rand < 'a'))
-            rand = chRandom::uniformInt('0', 'z');
-        s += (char)rand;
+    // The alphabet has 64 characters, so each 32-bit draw yields five
+    // uniformly distributed characters.
+    char* p = stream.reserve(length);
+    int i = 0;
+    while (i < length) {
+        uint32_t bits = chRandom::rng();
+        for (int j = 0; j < 5 && i < length; j++, i++) {
+            p[i] = alphanumeric64[bits & 63];
+            bits >>= 6;
+        }
     }
-    stream << s;
+    stream.commit(length);
     if (delimiter)
-        stream << csvDelim;
+        stream.delimiter();
 }
 
 void DataSource::addAlphanumeric64(int minLength, int maxLength,
-                                   std::ofstream& stream, bool delimiter) {
+                                   RowWriter& stream, bool delimiter) {
     addAlphanumeric64(chRandom::uniformInt(minLength, maxLength), stream,
                       delimiter);
 }
 
 void DataSource::addAlphanumeric64Original(int minLength, int maxLength,
-                                           std::ofstream& stream,
+                                           RowWriter& stream,
                                            bool delimiter) {
     int rLength = chRandom::uniformInt(minLength, maxLength);
     int rPosition = chRandom::uniformInt(0, rLength - 8);
     addAlphanumeric64(rPosition, stream, false);
-    stream << "ORIGINAL";
+    stream.put("ORIGINAL", 8);
     addAlphanumeric64(rLength - 8 - rPosition, stream, false);
     if (delimiter)
-        stream << csvDelim;
+        stream.delimiter();
 }
 
 void DataSource::addTextString(int minLength, int maxLength,
-                               std::ofstream& stream, bool delimiter) {
-    stream << tpchText(chRandom::uniformInt(minLength, maxLength));
+                               RowWriter& stream, bool delimiter) {
+    addText(chRandom::uniformInt(minLength, maxLength), stream);
     if (delimiter)
-        stream << csvDelim;
+        stream.delimiter();
 }
 
 void DataSource::addTextStringCustomer(int minLength, int maxLength,
                                        const char* action,
-                                       std::ofstream& stream, bool delimiter) {
+                                       RowWriter& stream, bool delimiter) {
     int rLength = chRandom::uniformInt(minLength, maxLength);
     int l1 = chRandom::uniformInt(0, rLength - 10 - 8);
     int l2 = chRandom::uniformInt(0, rLength - l1 - 10 - 8);
     int l3 = rLength - l1 - l2 - 18;
-    stream << tpchText(l1);
-    stream << "Customer";
-    stream << tpchText(l2);
-    stream << action;
-    stream << tpchText(l3);
+    addText(l1, stream);
+    stream.put("Customer");
+    addText(l2, stream);
+    stream.put(action);
+    addText(l3, stream);
     if (delimiter)
-        stream << csvDelim;
+        stream.delimiter();
 }
 
-void DataSource::addInt(int minValue, int maxValue, std::ofstream& stream,
+void DataSource::addInt(int minValue, int maxValue, RowWriter& stream,
                         bool delimiter) {
-    stream << chRandom::uniformInt(minValue, maxValue);
+    stream.putInt(chRandom::uniformInt(minValue, maxValue));
     if (delimiter)
-        stream << csvDelim;
+        stream.delimiter();
 }
 
-void DataSource::writeDouble(double d, std::ofstream& stream, bool delimiter) {
-    stream << d;
+void DataSource::writeDecimal(int64_t scaled, int decimals, RowWriter& stream,
+                              bool delimiter) {
+    stream.putDecimal(scaled, decimals);
     if (delimiter)
-        stream << csvDelim;
+        stream.delimiter();
 }
 
 void DataSource::addDouble(double minValue, double maxValue, int decimals,
-                           std::ofstream& stream, bool delimiter) {
-    double d = chRandom::uniformDouble(minValue, maxValue, decimals);
-    writeDouble(d, stream, delimiter);
+                           RowWriter& stream, bool delimiter) {
+    // Draw the value as an integer number of 10^-decimals units, which can
+    // be written out exactly without any floating point formatting.
+    double scale = pow(10.0, decimals);
+    int scaled = chRandom::uniformInt(lround(minValue * scale),
+                                      lround(maxValue * scale));
+    writeDecimal(scaled, decimals, stream, delimiter);
 }
 
-void DataSource::addNId(std::ofstream& stream, bool delimiter) {
-    int rand = 0;
-    while (rand == 0 || (rand > '9' && rand < 'A') ||
-           (rand > 'Z' && rand < 'a'))
-        rand = chRandom::uniformInt('0', 'z');
-    stream << rand;
+void DataSource::addNId(RowWriter& stream, bool delimiter) {
+    stream.putInt(alphanumeric62[chRandom::uniformInt(0, 61)]);
     if (delimiter)
-        stream << csvDelim;
+        stream.delimiter();
 }
 
-void DataSource::addWDCZip(std::ofstream& stream, bool delimiter) {
+void DataSource::addWDCZip(RowWriter& stream, bool delimiter) {
     addNumeric(4, stream, false);
-    stream << "11111";
+    stream.put("11111", 5);
     if (delimiter)
-        stream << csvDelim;
+        stream.delimiter();
 }
 
-void DataSource::addSuPhone(int& suId, std::ofstream& stream, bool delimiter) {
+void DataSource::addSuPhone(int& suId, RowWriter& stream, bool delimiter) {
     int country_code = (suId % 90) + 10; // ensure length 2
-    stream << country_code << "-";
+    stream.putInt(country_code);
+    stream.put('-');
     addInt(100, 999, stream, false);
-    stream << "-";
+    stream.put('-');
     addInt(100, 999, stream, false);
-    stream << "-";
+    stream.put('-');
     addInt(1000, 9999, stream, false);
     if (delimiter)
-        stream << csvDelim;
-}
-
-std::string DataSource::getCurrentTimeString(int64_t offset) {
-    time_t rawtime;
-    struct tm* timeinfo;
-    char buffer[24];
-    time(&rawtime);
-    rawtime += offset;
-    timeinfo = localtime(&rawtime);
-    strftime(buffer, 80, "%F %X", timeinfo);
-    return std::string(buffer);
+        stream.delimiter();
 }
 
-std::string DataSource::strLeadingZero(int i, int zeros) {
-    std::stringstream ss;
-    ss << std::setw(zeros) << std::setfill('0') << i;
-    return ss.str();
+void DataSource::addCLast(int cId, RowWriter& stream, bool delimiter) {
+    // The first 1000 customers of a district cover every last name once;
+    // the rest are drawn from NURand(255, 0, 999).
+    int value = cId <= 1000 ? cId - 1 : chRandom::nonUniformInt(255, 0, 999, 173);
+    stream.put(cLastParts[value / 100]);
+    stream.put(cLastParts[value / 10 % 10]);
+    stream.put(cLastParts[value % 10]);
+    if (delimiter)
+        stream.delimiter();
 }
 
 Nation DataSource::getNation(int i) { return nations[i]; }
 
 const char* DataSource::getRegion(int i) { return regions[i]; }
 
-std::string DataSource::randomState() {
+const char* DataSource::randomState() {
     assert(states.size() > 0);
     return states.at(chRandom::uniformInt(0, states.size() - 1));
 }
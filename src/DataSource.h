@@ -18,7 +18,9 @@ limitations under the License.
 #ifndef DATASOURCE_H
 #define DATASOURCE_H
 
-#include <fstream>
+#include "RowWriter.h"
+
+#include <cstdint>
 #include <sql.h>
 #include <sqlext.h>
 #include <sqltypes.h>
@@ -46,49 +48,49 @@ class DataSource {
     static const char* regions[];
     static int warehouseCount;
 
-    static std::string tpchText(int length);
-    static std::string tpchSentence();
-    static std::string tpchNounPhrase();
-    static std::string tpchVerbPhrase();
-    static std::string tpchPrepositionalPhrase();
+    static const std::string& textPool();
+    static void addText(int length, RowWriter& stream);
+    static void appendSentence(std::string& s);
+    static void appendNounPhrase(std::string& s);
+    static void appendVerbPhrase(std::string& s);
+    static void appendPrepositionalPhrase(std::string& s);
 
   public:
     static void initialize(int warehouseCount);
     static bool randomTrue(double probability);
     static int permute(int value, int low, int high);
-    static void getCurrentTimestamp(SQL_TIMESTAMP_STRUCT& ret, int64_t offset = 0);
     static void genCLast(int value, std::string& ret);
     static void randomCLast(std::string& ret);
     static void getRemoteWId(int& currentWId, int& ret);
-    static void addNumeric(int length, std::ofstream& stream, bool delimiter);
-    static void addAlphanumeric62(int length, std::ofstream& stream,
+    static void addNumeric(int length, RowWriter& stream, bool delimiter);
+    static void addAlphanumeric62(int length, RowWriter& stream,
                                   bool delimiter);
-    static void addAlphanumeric64(int length, std::ofstream& stream,
+    static void addAlphanumeric64(int length, RowWriter& stream,
                                   bool delimiter);
     static void addAlphanumeric64(int minLength, int maxLength,
-                                  std::ofstream& stream, bool delimiter);
+                                  RowWriter& stream, bool delimiter);
     static void addAlphanumeric64Original(int minLength, int maxLength,
-                                          std::ofstream& stream,
+                                          RowWriter& stream,
                                           bool delimiter);
     static void addTextString(int minLength, int maxLength,
-                              std::ofstream& stream, bool delimiter);
+                              RowWriter& stream, bool delimiter);
     static void addTextStringCustomer(int minLength, int maxLength,
-                                      const char* action, std::ofstream& stream,
+                                      const char* action, RowWriter& stream,
                                       bool delimiter);
-    static void addInt(int minValue, int maxValue, std::ofstream& stream,
+    static void addInt(int minValue, int maxValue, RowWriter& stream,
                        bool delimiter);
     static void addDouble(double minValue, double maxValue, int decimals,
-                          std::ofstream& stream, bool delimiter);
-    static void writeDouble(double d, std::ofstream& stream, bool delimiter);
-    static void addNId(std::ofstream& stream, bool delimiter);
-    static void addWDCZip(std::ofstream& stream, bool delimiter);
-    static void addSuPhone(int& suId, std::ofstream& stream, bool delimiter);
-    static std::string getCurrentTimeString(int64_t offset = 0);
-    static std::string strLeadingZero(int i, int zeros);
+                          RowWriter& stream, bool delimiter);
+    static void writeDecimal(int64_t scaled, int decimals, RowWriter& stream,
+                             bool delimiter);
+    static void addNId(RowWriter& stream, bool delimiter);
+    static void addWDCZip(RowWriter& stream, bool delimiter);
+    static void addSuPhone(int& suId, RowWriter& stream, bool delimiter);
+    static void addCLast(int cId, RowWriter& stream, bool delimiter);
     static Nation getNation(int i);
     static const char* getRegion(int i);
 
-    static std::string randomState();
+    static const char* randomState();
 };
 
 #endif
@@ -19,6 +19,8 @@ limitations under the License.
 
 #include "Log.h"
 
+#include <cstdlib>
+
 bool DbcTools::fetch(SQLHSTMT& hStmt, SQLCHAR* buf, SQLLEN* nIdicator,
                      int pos) {
     SQLRETURN ret = SQLFetch(hStmt);
@@ -68,6 +70,15 @@ bool DbcTools::autoCommitOff(SQLHDBC& hDBC) {
     return false;
 }
 
+bool DbcTools::autoCommitOn(SQLHDBC& hDBC) {
+    SQLRETURN ret = SQLSetConnectAttr(hDBC, SQL_ATTR_AUTOCOMMIT,
+                                      (SQLPOINTER) SQL_AUTOCOMMIT_ON, SQL_NTS);
+    if (reviewReturn(hDBC, SQL_HANDLE_DBC, ret, true))
+        return true;
+    Log::l2() << Log::tm() << "-autoCommitOn failed\n";
+    return false;
+}
+
 bool DbcTools::allocAndPrepareStmt(SQLHDBC& hDBC, SQLHSTMT& hStmt,
                                    const char* stmt) {
     if (hStmt != nullptr) {
@@ -133,6 +144,30 @@ bool DbcTools::bind(SQLHSTMT& hStmt, int pos, SQL_TIMESTAMP_STRUCT& ts) {
     return false;
 }
 
+bool DbcTools::bindArray(SQLHSTMT& hStmt, int pos, int width, char* buffer,
+                         SQLLEN* lengths) {
+    SQLRETURN ret = SQLBindParameter(hStmt, pos, SQL_PARAM_INPUT, SQL_C_CHAR,
+                                     SQL_VARCHAR, width, 0, buffer, width,
+                                     lengths);
+    if (reviewReturn(hStmt, SQL_HANDLE_STMT, ret))
+        return true;
+    Log::l1() << Log::tm() << "-bind string array failed\n";
+    return false;
+}
+
+bool DbcTools::setParamsetSize(SQLHSTMT& hStmt, SQLULEN size) {
+    SQLRETURN ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAM_BIND_TYPE,
+                                   (SQLPOINTER) SQL_PARAM_BIND_BY_COLUMN, 0);
+    if (reviewReturn(hStmt, SQL_HANDLE_STMT, ret)) {
+        ret = SQLSetStmtAttr(hStmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER) size,
+                             0);
+        if (reviewReturn(hStmt, SQL_HANDLE_STMT, ret))
+            return true;
+    }
+    Log::l1() << Log::tm() << "-setting paramset size failed\n";
+    return false;
+}
+
 bool DbcTools::executePreparedStatement(SQLHSTMT& hStmt) {
     SQLRETURN ret = SQLExecute(hStmt);
     if (reviewReturn(hStmt, SQL_HANDLE_STMT, ret)) {
@@ -246,6 +281,36 @@ bool DbcTools::fetch(SQLHSTMT& hStmt, SQLCHAR* buf, SQLLEN* nIdicator, int pos,
     return false;
 }
 
+bool DbcTools::fetch(SQLHSTMT& hStmt, int64_t* values, int count) {
+    SQLRETURN ret = SQLFetch(hStmt);
+    if (!reviewReturn(hStmt, SQL_HANDLE_STMT, ret)) {
+        Log::l1() << Log::tm() << "-fetch failed\n";
+        return false;
+    }
+    for (int i = 0; i < count; i++) {
+        SQLCHAR buf[64] = {0};
+        SQLLEN nIdicator = 0;
+        ret = SQLGetData(hStmt, i + 1, SQL_C_CHAR, buf, sizeof(buf),
+                         &nIdicator);
+        if (!reviewReturn(hStmt, SQL_HANDLE_STMT, ret)) {
+            Log::l1() << Log::tm() << "-fetch failed\n";
+            return false;
+        }
+        values[i] = nIdicator == SQL_NULL_DATA
+                        ? 0
+                        : strtoll((char*) buf, nullptr, 10);
+    }
+    return true;
+}
+
+int64_t DbcTools::rowCount(SQLHSTMT& hStmt) {
+    SQLLEN rows = -1;
+    SQLRETURN ret = SQLRowCount(hStmt, &rows);
+    if (ret != SQL_SUCCESS && ret != SQL_SUCCESS_WITH_INFO)
+        return -1;
+    return rows;
+}
+
 bool DbcTools::commit(SQLHDBC& hDBC) {
     Log::l1() << Log::tm() << "-commit\n";
     SQLRETURN ret = SQLEndTran(SQL_HANDLE_DBC, hDBC, SQL_COMMIT);
@@ -18,11 +18,24 @@ limitations under the License.
 #ifndef DBCTOOLS_H
 #define DBCTOOLS_H
 
+#include <cstdint>
 #include <sql.h>
 #include <sqlext.h>
 #include <sqltypes.h>
 #include <string>
 
+// Connection parameters for code that opens connections of its own, such as
+// the loaders of gen --load and the connections of a parallel import.
+struct LoadTarget {
+    SQLHENV hEnv;
+    const char* dsn;
+    const char* username;
+    const char* password;
+    // libpq connection string. If set, the tables are loaded with the
+    // dialect's COPY FROM STDIN statements over libpq instead of over ODBC.
+    const char* copyUrl;
+};
+
 class DbcTools {
 
   private:
@@ -36,6 +49,7 @@ class DbcTools {
     static bool connect(SQLHENV& hEnv, SQLHDBC& hDBC, const char* dsn,
                         const char* username, const char* password);
     static bool autoCommitOff(SQLHDBC& hDBC);
+    static bool autoCommitOn(SQLHDBC& hDBC);
     static bool allocAndPrepareStmt(SQLHDBC& hDBC, SQLHSTMT& hStmt,
                                     const char* stmt);
     static bool resetStatement(SQLHSTMT& hStmt);
@@ -43,6 +57,12 @@ class DbcTools {
     static bool bind(SQLHSTMT& hStmt, int pos, double& value);
     static bool bind(SQLHSTMT& hStmt, int pos, int bufferLength, char* buffer);
     static bool bind(SQLHSTMT& hStmt, int pos, SQL_TIMESTAMP_STRUCT& ts);
+    // Binds a column-wise array of strings for execution with a paramset
+    // size > 1. Element i starts at buffer + i * width and its length is
+    // lengths[i], or SQL_NULL_DATA.
+    static bool bindArray(SQLHSTMT& hStmt, int pos, int width, char* buffer,
+                          SQLLEN* lengths);
+    static bool setParamsetSize(SQLHSTMT& hStmt, SQLULEN size);
     static bool executePreparedStatement(SQLHSTMT& hStmt);
     static bool executeServiceStatement(SQLHSTMT& hStmt, const char* stmt,
                                         bool showError = 1);
@@ -52,6 +72,12 @@ class DbcTools {
                       int& value);
     static bool fetch(SQLHSTMT& hStmt, SQLCHAR* buf, SQLLEN* nIdicator, int pos,
                       double& value);
+    // Fetches the next row and reads its first count columns as 64-bit
+    // integers, NULL as 0.
+    static bool fetch(SQLHSTMT& hStmt, int64_t* values, int count);
+    // Rows that the last statement on hStmt affected, -1 if the driver
+    // cannot tell.
+    static int64_t rowCount(SQLHSTMT& hStmt);
     static bool commit(SQLHDBC& hDBC);
     static bool rollback(SQLHDBC& hDBC);
 };
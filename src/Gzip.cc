@@ -0,0 +1,248 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "Gzip.h"
+
+#include "Log.h"
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <err.h>
+#include <fcntl.h>
+#include <functional>
+#include <mutex>
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace {
+
+// Threads shared by all GzipSinks, so that the number of compressing threads
+// does not grow with the number of open tables and gen jobs.
+class CompressionPool {
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> threads;
+    bool stopping = false;
+
+    void work() {
+        for (;;) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [&] { return stopping || !tasks.empty(); });
+                if (tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+  public:
+    CompressionPool() {
+        unsigned n = std::thread::hardware_concurrency();
+        for (unsigned i = 0; i < (n ? n : 1); i++)
+            threads.emplace_back(&CompressionPool::work, this);
+    }
+
+    ~CompressionPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& t : threads)
+            t.join();
+    }
+
+    std::future<std::vector<char>> submit(std::vector<char> block) {
+        auto task = std::make_shared<std::packaged_task<std::vector<char>()>>(
+            [block = std::move(block)]() { return compress(block); });
+        auto result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace_back([task]() { (*task)(); });
+        }
+        ready.notify_one();
+        return result;
+    }
+
+    // Compresses block into a complete gzip member. Generation is the
+    // bottleneck we care about, so this favors speed over ratio.
+    static std::vector<char> compress(const std::vector<char>& block) {
+        z_stream zs = {};
+        if (deflateInit2(&zs, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8,
+                         Z_DEFAULT_STRATEGY) != Z_OK)
+            errx(1, "initializing gzip compression failed");
+        std::vector<char> out(deflateBound(&zs, block.size()));
+        zs.next_in = (Bytef*) block.data();
+        zs.avail_in = block.size();
+        zs.next_out = (Bytef*) out.data();
+        zs.avail_out = out.size();
+        if (deflate(&zs, Z_FINISH) != Z_STREAM_END)
+            errx(1, "gzip compression failed");
+        out.resize(zs.total_out);
+        deflateEnd(&zs);
+        return out;
+    }
+};
+
+CompressionPool& compressionPool() {
+    static CompressionPool pool;
+    return pool;
+}
+
+} // namespace
+
+GzipSink::GzipSink(const std::string& path) : file(path) {}
+
+void GzipSink::writeOldest() {
+    auto member = pending.front().get();
+    pending.pop_front();
+    file.write(member.data(), member.size());
+}
+
+void GzipSink::write(const char* data, size_t len) {
+    pending.push_back(
+        compressionPool().submit(std::vector<char>(data, data + len)));
+    if (pending.size() > maxPendingBlocks)
+        writeOldest();
+}
+
+void GzipSink::close() {
+    while (!pending.empty())
+        writeOldest();
+    file.close();
+}
+
+PipeSink::PipeSink(const std::string& fifo_, std::atomic<bool>& stop_)
+    : fifo(fifo_), stop(stop_) {
+    unlink(fifo.c_str());
+    created = mkfifo(fifo.c_str(), 0644) == 0;
+    if (!created) {
+        Log::l2() << Log::tm() << "-creating pipe " << fifo << " failed\n";
+        failed = stop = true;
+    }
+}
+
+PipeSink::~PipeSink() { close(); }
+
+bool PipeSink::open() {
+    if (fd == -1 && !failed && (fd = openPipeWriter(fifo, stop)) == -1)
+        failed = stop = true;
+    return !failed;
+}
+
+void PipeSink::write(const char* data, size_t len) {
+    if (open() && !writeAll(fd, data, len))
+        failed = stop = true;
+}
+
+void PipeSink::close() {
+    if (!created)
+        return;
+    // A table without rows still has to end the import reading it.
+    open();
+    if (fd != -1)
+        ::close(fd);
+    fd = -1;
+    unlink(fifo.c_str());
+    created = false;
+}
+
+GunzipPipe::GunzipPipe(const std::string& source_) : source(source_) {
+    fifo = source.substr(0, source.size() - strlen(gzipSuffix)) + ".fifo";
+    unlink(fifo.c_str());
+    if (mkfifo(fifo.c_str(), 0644) != 0) {
+        Log::l2() << Log::tm() << "-creating pipe " << fifo << " failed\n";
+        return;
+    }
+    thread = std::thread(&GunzipPipe::feed, this);
+}
+
+GunzipPipe::~GunzipPipe() { finish(); }
+
+int openPipeWriter(const std::string& fifo,
+                   const std::atomic<bool>& abandoned) {
+    // A reader that goes away early must fail the write with EPIPE rather
+    // than kill the process.
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &set, nullptr);
+
+    // Opening a pipe for writing blocks until there is a reader, which there
+    // never is if the import statement fails before opening the file.
+    int fd;
+    while ((fd = open(fifo.c_str(), O_WRONLY | O_NONBLOCK)) == -1) {
+        if (errno != ENXIO || abandoned)
+            return -1;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    return fd;
+}
+
+bool writeAll(int fd, const char* data, size_t len) {
+    for (size_t off = 0; off < len;) {
+        ssize_t w = ::write(fd, data + off, len - off);
+        if (w < 0 && errno == EINTR)
+            continue;
+        if (w < 0)
+            return false;
+        off += w;
+    }
+    return true;
+}
+
+void GunzipPipe::feed() {
+    gzFile in = gzopen(source.c_str(), "rb");
+    if (!in)
+        return;
+    gzbuffer(in, 1 << 17);
+
+    int fd = openPipeWriter(fifo, abandoned);
+    if (fd == -1) {
+        gzclose(in);
+        return;
+    }
+
+    std::vector<char> buf(1 << 20);
+    bool failed = false;
+    int n;
+    while (!failed && (n = gzread(in, buf.data(), buf.size())) > 0) {
+        failed = !writeAll(fd, buf.data(), n);
+    }
+    ok = !failed && n == 0;
+    gzclose(in);
+    ::close(fd);
+}
+
+bool GunzipPipe::finish() {
+    if (!thread.joinable())
+        return ok;
+    abandoned = true;
+    thread.join();
+    unlink(fifo.c_str());
+    if (!ok)
+        Log::l2() << Log::tm() << "-decompressing " << source << " failed\n";
+    return ok;
+}
@@ -0,0 +1,104 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include "RowWriter.h"
+
+#include <atomic>
+#include <deque>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Appended to the name of a compressed output file, e.g. "stock.tbl.03.gz".
+constexpr const char* gzipSuffix = ".gz";
+
+inline bool isGzipFile(const std::string& path) {
+    auto n = strlen(gzipSuffix);
+    return path.size() > n && path.compare(path.size() - n, n, gzipSuffix) == 0;
+}
+
+// A RowSink that writes a gzip-compressed file.
+//
+// Every block is compressed on a process-wide pool of threads into a gzip
+// member of its own. Concatenated members form a valid gzip file, so blocks
+// can be compressed concurrently and only need to be written in order.
+class GzipSink : public RowSink {
+    static constexpr size_t maxPendingBlocks = 4;
+
+    FileSink file;
+    std::deque<std::future<std::vector<char>>> pending;
+
+    void writeOldest();
+
+  public:
+    explicit GzipSink(const std::string& path);
+    void write(const char* data, size_t len) override;
+    void close() override;
+};
+
+// Opens the named pipe fifo for writing once a reader has opened it, or
+// returns -1 if that fails or abandoned is set first. Writes to it from the
+// calling thread fail with EPIPE rather than raise SIGPIPE.
+int openPipeWriter(const std::string& fifo,
+                   const std::atomic<bool>& abandoned);
+// Writes all of data to fd. Returns whether it could.
+bool writeAll(int fd, const char* data, size_t len);
+
+// Decompresses a gzip file into a named pipe, for importers that can only
+// read uncompressed files from a path. The pipe is created next to the file
+// and fed by a background thread once a reader opens it.
+class GunzipPipe {
+    std::string source;
+    std::string fifo;
+    std::atomic<bool> abandoned{false};
+    bool ok = false;
+    std::thread thread;
+
+    void feed();
+
+  public:
+    explicit GunzipPipe(const std::string& source);
+    ~GunzipPipe();
+    const std::string& path() const { return fifo; }
+    // Waits for the pipe to be drained, or gives up on it if nothing ever
+    // opened it, and removes it. Returns whether the whole file was passed
+    // through.
+    bool finish();
+};
+
+// A RowSink that writes the rows into a named pipe, which it creates, for
+// import statements that read the rows from a path while they are being
+// generated. The pipe is opened once the database opens it, and removed on
+// close. A pipe that fails to open or to take the rows sets stop, which
+// also gives up on the pipes that nothing opened yet, and drops the rows.
+class PipeSink : public RowSink {
+    std::string fifo;
+    std::atomic<bool>& stop;
+    int fd = -1;
+    bool created = false;
+    bool failed = false;
+
+    bool open();
+
+  public:
+    PipeSink(const std::string& fifo, std::atomic<bool>& stop);
+    ~PipeSink();
+    void write(const char* data, size_t len) override;
+    void close() override;
+};
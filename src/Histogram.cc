@@ -2,6 +2,8 @@
 // Created by brennan on 10/17/19.
 //
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include "Histogram.h"
 
@@ -38,3 +40,48 @@ Histogram &Histogram::operator+=(const Histogram &other) {
     }
     return *this;
 }
+
+void LatencyHistogram::record(uint64_t nanos) {
+    // Values below subBuckets get a bucket each, larger ones one of the
+    // subBuckets buckets of their power of two.
+    int bucket = nanos;
+    if (nanos >= subBuckets) {
+        int log2 = 63 - __builtin_clzll(nanos);
+        bucket = (log2 - 3) * subBuckets + ((nanos >> (log2 - 4)) & (subBuckets - 1));
+    }
+    ++counts[bucket];
+    ++total;
+}
+
+LatencyHistogram &LatencyHistogram::operator+=(const LatencyHistogram &other) {
+    for (int i = 0; i < bucketCount; ++i) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+    return *this;
+}
+
+LatencyHistogram &LatencyHistogram::operator-=(const LatencyHistogram &earlier) {
+    for (int i = 0; i < bucketCount; ++i) {
+        counts[i] -= earlier.counts[i];
+    }
+    total -= earlier.total;
+    return *this;
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = std::max<uint64_t>(1, std::ceil(q * total));
+    uint64_t seen = 0;
+    int bucket = 0;
+    while (bucket < bucketCount - 1 && (seen += counts[bucket]) < rank) {
+        ++bucket;
+    }
+    if (bucket < subBuckets) {
+        return bucket;
+    }
+    int shift = bucket / subBuckets - 1;
+    return (uint64_t(subBuckets + bucket % subBuckets + 1) << shift) - 1;
+}
@@ -10,3 +10,25 @@ public:
     void increment(uint64_t);
     std::vector<uint64_t> getCounts() const;
 };
+
+// Latencies in nanoseconds, in buckets no wider than 1/16 of their values, so
+// that percentiles are accurate to about 6% at any scale. Its size is fixed.
+// It is not synchronized; callers that read it while another thread records
+// into it must lock around both.
+class LatencyHistogram {
+    static constexpr int subBuckets = 16;
+    static constexpr int bucketCount = 61 * subBuckets;
+
+    uint64_t counts[bucketCount] = {};
+    uint64_t total = 0;
+
+public:
+    void record(uint64_t nanos);
+    LatencyHistogram& operator+=(const LatencyHistogram& other);
+    // Removes the latencies of an earlier copy, leaving those recorded since.
+    LatencyHistogram& operator-=(const LatencyHistogram& earlier);
+    uint64_t count() const { return total; }
+    // The latency that the fraction q of the recorded ones do not exceed, as
+    // the upper bound of its bucket, or 0 if none were recorded.
+    uint64_t percentile(double q) const;
+};
@@ -0,0 +1,93 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "LoadReport.h"
+
+#include "Log.h"
+
+std::mutex LoadReport::mutex;
+std::vector<LoadStep> LoadReport::steps;
+
+void LoadReport::add(LoadStep step) {
+    std::lock_guard<std::mutex> lock(mutex);
+    steps.push_back(std::move(step));
+}
+
+bool LoadReport::time(const char* step, const std::function<bool()>& fn) {
+    Stopwatch watch;
+    bool ok = fn();
+    if (ok) {
+        LoadStep whole;
+        whole.step = step;
+        whole.seconds = watch.seconds();
+        // The rows and bytes of a step are those of its parts.
+        for (const auto& s : get()) {
+            if (s.step != step || s.object.empty())
+                continue;
+            if (s.rows >= 0)
+                whole.rows = (whole.rows < 0 ? 0 : whole.rows) + s.rows;
+            if (s.bytes >= 0)
+                whole.bytes = (whole.bytes < 0 ? 0 : whole.bytes) + s.bytes;
+        }
+        Log::l2() << Log::tm() << "-took " << whole.seconds << " s\n";
+        add(std::move(whole));
+    }
+    return ok;
+}
+
+std::vector<LoadStep> LoadReport::get() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return steps;
+}
+
+void LoadReport::print(FILE* out) {
+    bool first = true;
+    for (const auto& s : get()) {
+        if (!s.object.empty())
+            continue;
+        if (first)
+            fprintf(out, "\n");
+        first = false;
+        fprintf(out, "%-24s%.1f s", (s.step + ":").c_str(), s.seconds);
+        if (s.rows >= 0 && s.seconds > 0)
+            fprintf(out, ", %.0f rows/s", s.rows / s.seconds);
+        if (s.bytes >= 0 && s.seconds > 0)
+            fprintf(out, ", %.1f MB/s", s.bytes / s.seconds / 1e6);
+        fprintf(out, "\n");
+    }
+}
+
+void LoadReport::printJson(FILE* out) {
+    auto all = get();
+    fprintf(out, "[\n");
+    for (size_t i = 0; i < all.size(); i++) {
+        const auto& s = all[i];
+        fprintf(out,
+                "    {\"step\": \"%s\", \"object\": \"%s\", \"seconds\": %.6f",
+                s.step.c_str(), s.object.c_str(), s.seconds);
+        // Rates are left out of steps too short to measure.
+        if (s.rows >= 0)
+            fprintf(out, ", \"rows\": %lld", (long long) s.rows);
+        if (s.rows >= 0 && s.seconds > 0)
+            fprintf(out, ", \"rows_per_sec\": %.1f", s.rows / s.seconds);
+        if (s.bytes >= 0)
+            fprintf(out, ", \"bytes\": %lld", (long long) s.bytes);
+        if (s.bytes >= 0 && s.seconds > 0)
+            fprintf(out, ", \"bytes_per_sec\": %.1f", s.bytes / s.seconds);
+        fprintf(out, "}%s\n", i + 1 < all.size() ? "," : "");
+    }
+    fprintf(out, "  ]");
+}
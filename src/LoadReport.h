@@ -0,0 +1,70 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Measures wall-clock time from its construction.
+class Stopwatch {
+    std::chrono::steady_clock::time_point started =
+        std::chrono::steady_clock::now();
+
+  public:
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                             started)
+            .count();
+    }
+};
+
+// One timed step of run's setup, such as "import", or one table or file
+// within it.
+struct LoadStep {
+    std::string step;
+    // Table or file, empty for the step as a whole.
+    std::string object;
+    double seconds = 0;
+    // Rows affected as reported by the server, -1 if unknown.
+    int64_t rows = -1;
+    // Bytes of the files read, -1 if there are none.
+    int64_t bytes = -1;
+};
+
+// The timings of run's setup, which run prints and writes into --report
+// next to the results. Steps of different connections may be added
+// concurrently.
+class LoadReport {
+    static std::mutex mutex;
+    static std::vector<LoadStep> steps;
+
+  public:
+    static void add(LoadStep step);
+    // Runs fn as the whole of step, logs how long it took and adds that.
+    // Returns what fn returned.
+    static bool time(const char* step, const std::function<bool()>& fn);
+    static std::vector<LoadStep> get();
+    // Prints the whole steps as a table after a blank line, for the results.
+    static void print(FILE* out);
+    // Prints every step as a JSON array.
+    static void printJson(FILE* out);
+};
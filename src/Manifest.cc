@@ -0,0 +1,155 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "Manifest.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+void Manifest::add(Table t, const TableSummary& summary) {
+    std::lock_guard<std::mutex> lock(mutex);
+    tables[static_cast<int>(t)].rows += summary.rows;
+    tables[static_cast<int>(t)].checksum += summary.checksum;
+}
+
+bool Manifest::append(const Manifest& next) {
+    if (next.seed != seed || next.firstWarehouse != lastWarehouse + 1)
+        return false;
+    lastWarehouse = next.lastWarehouse;
+    partitions = 0;
+    for (int i = 0; i < tableCount; i++) {
+        if (!isWarehouseScoped(static_cast<Table>(i)))
+            continue;
+        tables[i].rows += next.tables[i].rows;
+        tables[i].checksum += next.tables[i].checksum;
+    }
+    return true;
+}
+
+bool Manifest::read(const std::string& path) {
+    FILE* f = fopen(path.c_str(), "r");
+    if (!f)
+        return false;
+    bool seenSeed = false, seenWarehouses = false;
+    int seenTables = 0;
+    char key[32];
+    while (fscanf(f, "%31s", key) == 1) {
+        if (strcmp(key, "seed") == 0) {
+            seenSeed = fscanf(f, "%" SCNu64, &seed) == 1;
+            continue;
+        }
+        if (strcmp(key, "warehouses") == 0) {
+            seenWarehouses =
+                fscanf(f, "%d %d", &firstWarehouse, &lastWarehouse) == 2;
+            continue;
+        }
+        if (strcmp(key, "partitions") == 0) {
+            if (fscanf(f, "%d", &partitions) != 1)
+                break;
+            continue;
+        }
+        int i = 0;
+        while (i < tableCount && strcmp(key, tableName(static_cast<Table>(i))))
+            i++;
+        if (i == tableCount ||
+            fscanf(f, "%" SCNd64 " %" SCNd64, &tables[i].rows,
+                   &tables[i].checksum) != 2)
+            break;
+        seenTables++;
+    }
+    fclose(f);
+    return seenSeed && seenWarehouses && seenTables == tableCount;
+}
+
+std::string Manifest::text() const {
+    char line[128];
+    std::string text;
+    snprintf(line, sizeof(line), "seed %" PRIu64 "\n", seed);
+    text += line;
+    snprintf(line, sizeof(line), "warehouses %d %d\n", firstWarehouse,
+             lastWarehouse);
+    text += line;
+    if (partitions > 0) {
+        snprintf(line, sizeof(line), "partitions %d\n", partitions);
+        text += line;
+    }
+    for (int i = 0; i < tableCount; i++) {
+        snprintf(line, sizeof(line), "%s %" PRId64 " %" PRId64 "\n",
+                 tableName(static_cast<Table>(i)), tables[i].rows,
+                 tables[i].checksum);
+        text += line;
+    }
+    return text;
+}
+
+std::string Manifest::digest() const {
+    // 64-bit FNV-1a of the text
+    Manifest data;
+    data.seed = seed;
+    data.firstWarehouse = firstWarehouse;
+    data.lastWarehouse = lastWarehouse;
+    std::copy(tables, tables + tableCount, data.tables);
+    uint64_t h = 0xcbf29ce484222325;
+    for (char c : data.text()) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3;
+    }
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016" PRIx64, h);
+    return hex;
+}
+
+bool Manifest::write(const std::string& path) const {
+    // Written next to its final name and renamed into place, so that an
+    // interrupted gen does not leave a manifest behind that looks complete.
+    auto tmp = path + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "w");
+    if (!f)
+        return false;
+    auto t = text();
+    bool ok = fwrite(t.data(), 1, t.size(), f) == t.size();
+    ok = fclose(f) == 0 && ok;
+    return ok && rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+ChecksumSink::ChecksumSink(std::unique_ptr<RowSink> sink_, Table t,
+                           Manifest& manifest_)
+    : sink(std::move(sink_)), table(t), field(checksumField(t)),
+      manifest(manifest_) {}
+
+void ChecksumSink::write(const char* data, size_t len) {
+    const char* p = data;
+    const char* end = data + len;
+    while (p < end) {
+        for (int f = 0; f < field; f++)
+            p = static_cast<const char*>(memchr(p, '|', end - p)) + 1;
+        int64_t v = 0;
+        for (; *p >= '0' && *p <= '9'; p++)
+            v = v * 10 + (*p - '0');
+        summary.checksum += v;
+        summary.rows++;
+        p = static_cast<const char*>(memchr(p, '\n', end - p)) + 1;
+    }
+    sink->write(data, len);
+}
+
+void ChecksumSink::close() {
+    sink->close();
+    manifest.add(table, summary);
+    summary = TableSummary();
+}
@@ -0,0 +1,85 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include "RowWriter.h"
+#include "Tables.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Name of the manifest that gen writes into its output directory.
+constexpr const char* manifestFileName = "manifest";
+
+// Row count and checksum of a table, the sum of its checksumField.
+struct TableSummary {
+    int64_t rows = 0;
+    int64_t checksum = 0;
+
+    bool operator==(const TableSummary& o) const {
+        return rows == o.rows && checksum == o.checksum;
+    }
+    bool operator!=(const TableSummary& o) const { return !(*this == o); }
+};
+
+// What gen produced: the seed, the warehouse range, and a summary of every
+// table, so that a loaded database can be checked against it. Written as
+// lines of "seed <key>", "warehouses <first> <last>", optionally
+// "partitions <count>", and "<table> <rows> <checksum>".
+class Manifest {
+    std::mutex mutex;
+
+  public:
+    uint64_t seed = 0;
+    int firstWarehouse = 0;
+    int lastWarehouse = 0;
+    // Number of ranges of warehouses that gen wrote shards of, see
+    // partitionBounds(), or 0 if the shards do not follow them.
+    int partitions = 0;
+    TableSummary tables[tableCount];
+
+    // Adds the rows of one output of table t. Safe to call from gen jobs
+    // concurrently.
+    void add(Table t, const TableSummary& summary);
+    // Adds the warehouses of next, which must continue this manifest's range
+    // with the same seed. Returns whether it did.
+    bool append(const Manifest& next);
+    bool read(const std::string& path);
+    bool write(const std::string& path) const;
+    // The manifest as written to its file.
+    std::string text() const;
+    // 16 hex digits that identify the dataset, for the fingerprint table.
+    // The partitions do not change the data and are left out.
+    std::string digest() const;
+};
+
+// A RowSink that passes the rows on to another sink, and on close adds their
+// count and checksum to a manifest.
+class ChecksumSink : public RowSink {
+    std::unique_ptr<RowSink> sink;
+    Table table;
+    int field;
+    Manifest& manifest;
+    TableSummary summary;
+
+  public:
+    ChecksumSink(std::unique_ptr<RowSink> sink, Table t, Manifest& manifest);
+    void write(const char* data, size_t len) override;
+    void close() override;
+};
@@ -0,0 +1,136 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "OdbcLoader.h"
+
+#include "DbcTools.h"
+
+#include <algorithm>
+#include <err.h>
+
+OdbcLoader::OdbcLoader(const LoadTarget& target, const char* table_,
+                       const char* insertStmt)
+    : table(table_) {
+    columns = std::count(insertStmt, insertStmt + strlen(insertStmt), '?');
+    SQLHENV hEnv = target.hEnv;
+    if (!DbcTools::connect(hEnv, hDBC, target.dsn, target.username,
+                           target.password)) {
+        errx(1, "connecting loader for %s failed", table.c_str());
+    }
+    if (!DbcTools::allocAndPrepareStmt(hDBC, hStmt, insertStmt)) {
+        errx(1, "preparing insert into %s failed", table.c_str());
+    }
+    values.resize(columns);
+    lengths.resize(columns);
+    thread = std::thread(&OdbcLoader::loaderThread, this);
+}
+
+OdbcLoader::~OdbcLoader() {
+    close();
+    SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+    SQLDisconnect(hDBC);
+    SQLFreeHandle(SQL_HANDLE_DBC, hDBC);
+}
+
+void OdbcLoader::write(const char* data, size_t len) {
+    std::vector<char> block(data, data + len);
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [&] { return queue.size() < maxQueuedBlocks; });
+    queue.push_back(std::move(block));
+    changed.notify_all();
+}
+
+void OdbcLoader::close() {
+    if (!thread.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+        changed.notify_all();
+    }
+    thread.join();
+}
+
+void OdbcLoader::loaderThread() {
+    for (;;) {
+        std::vector<char> block;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return closing || !queue.empty(); });
+            if (queue.empty())
+                return;
+            block = std::move(queue.front());
+            queue.pop_front();
+            changed.notify_all();
+        }
+        insert(block);
+    }
+}
+
+// Splits a block of pipe-delimited rows into one fixed-width array per
+// column and inserts them with a single execution. Empty fields are bound as
+// NULL, as the dialects' bulk imports do for O_CARRIER_ID and OL_DELIVERY_D.
+void OdbcLoader::insert(const std::vector<char>& block) {
+    const char* begin = block.data();
+    const char* end = begin + block.size();
+
+    // First pass: count rows and find the widest value of each column.
+    size_t rows = 0;
+    std::vector<int> widths(columns, 1);
+    for (const char* p = begin; p < end; rows++) {
+        for (int c = 0; c < columns; c++) {
+            const char* field = p;
+            while (p < end && *p != '|' && *p != '\n')
+                p++;
+            widths[c] = std::max(widths[c], static_cast<int>(p - field));
+            bool last = c == columns - 1;
+            if (p == end || (*p == '\n') != last) {
+                errx(1, "row %zu of %s does not have %d columns", rows,
+                     table.c_str(), columns);
+            }
+            p++;
+        }
+    }
+
+    for (int c = 0; c < columns; c++) {
+        values[c].resize(rows * widths[c]);
+        lengths[c].resize(rows);
+    }
+
+    // Second pass: copy the fields into the arrays.
+    const char* p = begin;
+    for (size_t r = 0; r < rows; r++) {
+        for (int c = 0; c < columns; c++) {
+            const char* field = p;
+            while (*p != '|' && *p != '\n')
+                p++;
+            size_t n = p - field;
+            memcpy(values[c].data() + r * widths[c], field, n);
+            lengths[c][r] = n == 0 ? SQL_NULL_DATA : static_cast<SQLLEN>(n);
+            p++;
+        }
+    }
+
+    bool ok = DbcTools::resetStatement(hStmt) &&
+              DbcTools::setParamsetSize(hStmt, rows);
+    for (int c = 0; ok && c < columns; c++) {
+        ok = DbcTools::bindArray(hStmt, c + 1, widths[c], values[c].data(),
+                                 lengths[c].data());
+    }
+    if (!ok || !DbcTools::executePreparedStatement(hStmt)) {
+        errx(1, "inserting into %s failed", table.c_str());
+    }
+}
@@ -0,0 +1,67 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include "DbcTools.h"
+#include "RowWriter.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sql.h>
+#include <sqltypes.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A RowSink that inserts the rows it is handed straight into a table, instead
+// of going through a .tbl file and the dialect's bulk import.
+//
+// Each loader owns a connection and a background thread. Blocks written by
+// the generator are queued and the thread executes them as one INSERT with a
+// parameter array of all the block's rows, so that generating the next block
+// overlaps with the database ingesting the previous one. The queue is
+// bounded, so a slow database throttles generation rather than buffering the
+// whole table in memory.
+class OdbcLoader : public RowSink {
+    static constexpr size_t maxQueuedBlocks = 2;
+
+    std::string table;
+    int columns;
+    SQLHDBC hDBC = nullptr;
+    SQLHSTMT hStmt = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::vector<char>> queue;
+    bool closing = false;
+    std::thread thread;
+
+    // Column-wise parameter arrays for the block being inserted.
+    std::vector<std::vector<char>> values;
+    std::vector<std::vector<SQLLEN>> lengths;
+
+    void loaderThread();
+    void insert(const std::vector<char>& block);
+
+  public:
+    OdbcLoader(const LoadTarget& target, const char* table,
+               const char* insertStmt);
+    ~OdbcLoader();
+    void write(const char* data, size_t len) override;
+    void close() override;
+};
@@ -0,0 +1,139 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "PgCopy.h"
+
+#include "Log.h"
+
+#include <cstdlib>
+#include <err.h>
+#include <memory>
+#include <zlib.h>
+
+PgCopy::PgCopy(const char* url, const char* copyStmt) : PgCopy(url) {
+    if (connected())
+        start(copyStmt);
+}
+
+PgCopy::PgCopy(const char* url) {
+    conn = PQconnectdb(url);
+    if (PQstatus(conn) != CONNECTION_OK)
+        fail("connecting");
+}
+
+bool PgCopy::start(const char* copyStmt) {
+    PGresult* res = PQexec(conn, copyStmt);
+    copying = PQresultStatus(res) == PGRES_COPY_IN;
+    PQclear(res);
+    return copying || fail("starting copy");
+}
+
+bool PgCopy::exec(const std::string& stmt) {
+    PGresult* res = PQexec(conn, stmt.c_str());
+    bool ok = PQresultStatus(res) == PGRES_COMMAND_OK;
+    PQclear(res);
+    return ok || fail(stmt.c_str());
+}
+
+PgCopy::~PgCopy() {
+    if (copying)
+        PQputCopyEnd(conn, "abandoned");
+    PQfinish(conn);
+}
+
+bool PgCopy::fail(const char* what) {
+    Log::l2() << Log::tm() << "-" << what << " failed: "
+              << PQerrorMessage(conn);
+    return false;
+}
+
+bool PgCopy::put(const char* data, size_t len) {
+    if (PQputCopyData(conn, data, static_cast<int>(len)) != 1)
+        return fail("copy");
+    return true;
+}
+
+bool PgCopy::end() {
+    if (!copying)
+        return false;
+    copying = false;
+    if (PQputCopyEnd(conn, nullptr) != 1)
+        return fail("ending copy");
+    bool ok = true;
+    while (PGresult* res = PQgetResult(conn)) {
+        if (PQresultStatus(res) != PGRES_COMMAND_OK)
+            ok = false;
+        else
+            copied = strtoll(PQcmdTuples(res), nullptr, 10);
+        PQclear(res);
+    }
+    return ok || fail("copy");
+}
+
+bool PgCopy::copyFile(const char* url, const char* copyStmt,
+                      const std::string& path, int64_t& rows) {
+    // gzread passes files that are not gzip-compressed through unchanged.
+    gzFile in = gzopen(path.c_str(), "rb");
+    if (!in) {
+        Log::l2() << Log::tm() << "-opening " << path << " failed\n";
+        return false;
+    }
+    gzbuffer(in, 1 << 20);
+
+    PgCopy copy(url, copyStmt);
+    bool ok = copy.ok();
+    std::unique_ptr<char[]> buf(new char[RowWriter::bufferSize]);
+    while (ok) {
+        int n = gzread(in, buf.get(), RowWriter::bufferSize);
+        if (n < 0) {
+            Log::l2() << Log::tm() << "-reading " << path << " failed\n";
+            ok = false;
+        } else if (n == 0) {
+            break;
+        } else {
+            ok = copy.put(buf.get(), n);
+        }
+    }
+    gzclose(in);
+    ok = ok && copy.end();
+    rows = copy.rows();
+    return ok;
+}
+
+PgCopyLoader::PgCopyLoader(const char* url, const char* table_,
+                           const char* copyStmt)
+    : table(table_), copy(url, copyStmt) {
+    if (!copy.ok()) {
+        errx(1, "starting copy into %s failed", table.c_str());
+    }
+}
+
+PgCopyLoader::~PgCopyLoader() { close(); }
+
+void PgCopyLoader::write(const char* data, size_t len) {
+    if (!copy.put(data, len)) {
+        errx(1, "copying into %s failed", table.c_str());
+    }
+}
+
+void PgCopyLoader::close() {
+    if (closed)
+        return;
+    closed = true;
+    if (!copy.end()) {
+        errx(1, "copying into %s failed", table.c_str());
+    }
+}
@@ -0,0 +1,76 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include "RowWriter.h"
+
+#include <cstdint>
+#include <libpq-fe.h>
+#include <string>
+
+// COPY ... FROM STDIN over a libpq connection of its own. The rows are sent
+// in the text format that gen writes, so blocks of .tbl data can be passed
+// through unchanged.
+class PgCopy {
+    PGconn* conn = nullptr;
+    bool copying = false;
+    int64_t copied = 0;
+
+    bool fail(const char* what);
+
+  public:
+    // Connects to url and starts copyStmt. Check ok() before use.
+    PgCopy(const char* url, const char* copyStmt);
+    // Only connects to url, for a series of COPYs with start() and end().
+    explicit PgCopy(const char* url);
+    ~PgCopy();
+    PgCopy(const PgCopy&) = delete;
+    PgCopy& operator=(const PgCopy&) = delete;
+
+    bool ok() const { return copying; }
+    bool connected() const { return PQstatus(conn) == CONNECTION_OK; }
+    // Starts copyStmt, e.g. after the last COPY ended.
+    bool start(const char* copyStmt);
+    // Runs a statement other than COPY, e.g. BEGIN or COMMIT.
+    bool exec(const std::string& stmt);
+    bool put(const char* data, size_t len);
+    // Ends the COPY. Returns whether the server accepted every row.
+    bool end();
+    // Rows that the server reported for the last COPY that ended.
+    int64_t rows() const { return copied; }
+
+    // Copies the file at path, gzip-compressed or not, with copyStmt, and
+    // sets rows to the number of rows copied.
+    static bool copyFile(const char* url, const char* copyStmt,
+                         const std::string& path, int64_t& rows);
+};
+
+// A RowSink that streams the rows it is handed into a table with COPY, the
+// fastest way into PostgreSQL and Materialize. libpq buffers and sends the
+// data as it comes, so unlike OdbcLoader no thread of its own is needed to
+// overlap generation with ingestion.
+class PgCopyLoader : public RowSink {
+    std::string table;
+    PgCopy copy;
+    bool closed = false;
+
+  public:
+    PgCopyLoader(const char* url, const char* table, const char* copyStmt);
+    ~PgCopyLoader();
+    void write(const char* data, size_t len) override;
+    void close() override;
+};
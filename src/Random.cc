@@ -18,6 +18,15 @@ limitations under the License.
 
 namespace chRandom {
 
-thread_local std::mt19937 rng{std::random_device()()};
+static uint64_t randomSeed() {
+    std::random_device rd;
+    return (uint64_t(rd()) << 32) | rd();
+}
+
+thread_local Philox rng{randomSeed()};
+
+uint64_t seedKey = randomSeed();
+
+void setSeed(uint64_t seed) { seedKey = seed; }
 
 } // namespace chRandom
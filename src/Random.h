@@ -16,12 +16,102 @@ limitations under the License.
 
 #pragma once
 
+#include <cmath>
+#include <cstdint>
 #include <random>
 #include <variant>
 
 namespace chRandom {
 
-extern thread_local std::mt19937 rng;
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random
+// Numbers: As Easy as 1, 2, 3"). Its output is a pure function of a 64-bit
+// key and a 128-bit counter, so any position in any stream can be reached
+// directly with seek. Satisfies UniformRandomBitGenerator.
+class Philox {
+  public:
+    using result_type = uint32_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+  private:
+    uint32_t key[2] = {0, 0};
+    uint32_t counter[4] = {0, 0, 0, 0};
+    uint32_t out[4] = {0, 0, 0, 0};
+    int next = 4;
+
+    static void mulhilo(uint32_t a, uint32_t b, uint32_t& hi, uint32_t& lo) {
+        uint64_t product = uint64_t(a) * b;
+        hi = product >> 32;
+        lo = uint32_t(product);
+    }
+
+    void generate() {
+        uint32_t k0 = key[0], k1 = key[1];
+        uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2],
+                 c3 = counter[3];
+        for (int round = 0; round < 10; round++) {
+            uint32_t hi0, lo0, hi1, lo1;
+            mulhilo(0xD2511F53, c0, hi0, lo0);
+            mulhilo(0xCD9E8D57, c2, hi1, lo1);
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+        counter[3]++;
+        next = 0;
+    }
+
+  public:
+    explicit Philox(uint64_t seed = 0) { this->seed(seed); }
+
+    void seed(uint64_t seed) {
+        key[0] = uint32_t(seed);
+        key[1] = uint32_t(seed >> 32);
+        counter[0] = counter[1] = counter[2] = counter[3] = 0;
+        next = 4;
+    }
+
+    // Moves to the start of the stream identified by (seed, c0, c1, c2).
+    void seek(uint64_t seed, uint32_t c0, uint32_t c1, uint32_t c2) {
+        key[0] = uint32_t(seed);
+        key[1] = uint32_t(seed >> 32);
+        counter[0] = c0;
+        counter[1] = c1;
+        counter[2] = c2;
+        counter[3] = 0;
+        next = 4;
+    }
+
+    result_type operator()() {
+        if (next == 4)
+            generate();
+        return out[next++];
+    }
+};
+
+extern thread_local Philox rng;
+
+// Key shared by every generated stream. Random unless set with setSeed.
+extern uint64_t seedKey;
+
+// Sets the key for all data generation streams. Must be called before any
+// generator threads start.
+void setSeed(uint64_t seed);
+
+// Positions this thread's generator at the start of the stream for one row,
+// identified by a table (or other stream) id, a warehouse and a row number
+// within that warehouse. Generating a row only ever consumes its own stream,
+// so rows can be generated independently and in any order.
+inline void seek(uint32_t stream, uint32_t wId, uint32_t row) {
+    rng.seek(seedKey, stream, wId, row);
+}
 
 class int_distribution {
 public:
@@ -39,6 +129,9 @@ public:
     template <class Generator>
     int operator()(Generator& g) {
         return std::visit([&g](auto&& arg) {
+            // Some distributions cache values between calls; drop them so
+            // that a draw only depends on the generator's position.
+            arg.reset();
             return arg(g);
         }, inner);
     }
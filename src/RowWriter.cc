@@ -0,0 +1,133 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "RowWriter.h"
+
+#include <cerrno>
+#include <err.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Room for one more row past bufferSize, so that endRow's flush check never
+// has to grow the buffer for ordinary rows.
+static constexpr size_t rowSlack = 64 * 1024;
+
+FileSink::FileSink(const std::string& p) : path(p) {
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        err(1, "opening %s", path.c_str());
+    }
+}
+
+FileSink::~FileSink() { close(); }
+
+void FileSink::write(const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            err(1, "writing %s", path.c_str());
+        }
+        data += n;
+        len -= n;
+    }
+}
+
+void FileSink::close() {
+    if (fd == -1)
+        return;
+    if (::close(fd) != 0) {
+        err(1, "closing %s", path.c_str());
+    }
+    fd = -1;
+}
+
+RowWriter::~RowWriter() { close(); }
+
+void RowWriter::open(const std::string& path) {
+    open(std::unique_ptr<RowSink>(new FileSink(path)));
+}
+
+void RowWriter::open(std::unique_ptr<RowSink> s) {
+    close();
+    sink = std::move(s);
+    if (!buf) {
+        capacity = bufferSize + rowSlack;
+        buf.reset(new char[capacity]);
+    }
+    len = 0;
+}
+
+void RowWriter::close() {
+    if (!sink)
+        return;
+    flush();
+    sink->close();
+    sink.reset();
+}
+
+void RowWriter::grow(size_t n) {
+    size_t newCapacity = capacity ? capacity : bufferSize + rowSlack;
+    while (len + n > newCapacity)
+        newCapacity *= 2;
+    std::unique_ptr<char[]> newBuf(new char[newCapacity]);
+    if (len > 0)
+        memcpy(newBuf.get(), buf.get(), len);
+    buf = std::move(newBuf);
+    capacity = newCapacity;
+}
+
+void RowWriter::flush() {
+    if (len > 0)
+        sink->write(buf.get(), len);
+    len = 0;
+}
+
+void RowWriter::putInt(int64_t v, int width) {
+    char digits[20];
+    auto end = std::to_chars(digits, digits + sizeof(digits), v).ptr;
+    int n = end - digits;
+    char* p = reserve(width > n ? width : n);
+    for (; n < width; width--)
+        *p++ = '0';
+    memcpy(p, digits, n);
+    len = p + n - buf.get();
+}
+
+void RowWriter::putDecimal(int64_t scaled, int decimals) {
+    char* p = reserve(24 + decimals);
+    char* start = p;
+    uint64_t magnitude = scaled;
+    if (scaled < 0) {
+        *p++ = '-';
+        magnitude = -magnitude;
+    }
+    uint64_t divisor = 1;
+    for (int i = 0; i < decimals; i++)
+        divisor *= 10;
+    p = std::to_chars(p, p + 20, magnitude / divisor).ptr;
+    if (decimals > 0) {
+        *p++ = '.';
+        uint64_t fraction = magnitude % divisor;
+        for (int i = decimals - 1; i >= 0; i--) {
+            p[i] = '0' + fraction % 10;
+            fraction /= 10;
+        }
+        p += decimals;
+    }
+    len += p - start;
+}
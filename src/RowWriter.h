@@ -0,0 +1,129 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+// Destination of the rows produced by a RowWriter. Each write hands the sink
+// a block of complete, newline-terminated rows.
+class RowSink {
+  public:
+    virtual ~RowSink() {}
+    virtual void write(const char* data, size_t len) = 0;
+    virtual void close() = 0;
+};
+
+// Writes blocks to a file.
+class FileSink : public RowSink {
+    int fd;
+    std::string path;
+
+  public:
+    explicit FileSink(const std::string& path);
+    ~FileSink();
+    void write(const char* data, size_t len) override;
+    void close() override;
+};
+
+// Writes pipe-delimited rows for one generated table.
+//
+// Rows are assembled in place in a large reusable buffer, which is handed to
+// the sink in one piece once it fills up. Flushes only ever happen at row
+// boundaries, so every write hands the sink a run of complete rows.
+class RowWriter {
+  public:
+    static constexpr size_t bufferSize = 1 << 20;
+
+  private:
+    std::unique_ptr<char[]> buf;
+    size_t capacity = 0;
+    size_t len = 0;
+    std::unique_ptr<RowSink> sink;
+
+    void grow(size_t n);
+    void flush();
+
+  public:
+    RowWriter() = default;
+    RowWriter(const RowWriter&) = delete;
+    RowWriter& operator=(const RowWriter&) = delete;
+    ~RowWriter();
+
+    // Writes the rows to the file at path.
+    void open(const std::string& path);
+    void open(std::unique_ptr<RowSink> sink);
+    void close();
+    bool isOpen() const { return sink != nullptr; }
+
+    // Returns space for n more bytes of the current row. The caller fills it
+    // in and then calls commit with the number of bytes actually used.
+    char* reserve(size_t n) {
+        if (len + n > capacity)
+            grow(n);
+        return buf.get() + len;
+    }
+    void commit(size_t n) { len += n; }
+
+    void put(char c) { *reserve(1) = c; len++; }
+    void put(const char* s, size_t n) {
+        memcpy(reserve(n), s, n);
+        len += n;
+    }
+    void put(const char* s) { put(s, strlen(s)); }
+    void put(const std::string& s) { put(s.data(), s.size()); }
+
+    void putInt(int64_t v) {
+        char* p = reserve(20);
+        len = std::to_chars(p, p + 20, v).ptr - buf.get();
+    }
+    // Writes v left-padded with zeros to width digits.
+    void putInt(int64_t v, int width);
+    // Writes scaled / 10^decimals with exactly decimals fractional digits,
+    // e.g. putDecimal(-1234, 2) writes "-12.34".
+    void putDecimal(int64_t scaled, int decimals);
+
+    void delimiter() { put('|'); }
+    void endRow() {
+        put('\n');
+        if (len >= bufferSize)
+            flush();
+    }
+};
+
+inline RowWriter& operator<<(RowWriter& w, char c) {
+    w.put(c);
+    return w;
+}
+
+inline RowWriter& operator<<(RowWriter& w, const char* s) {
+    w.put(s);
+    return w;
+}
+
+inline RowWriter& operator<<(RowWriter& w, const std::string& s) {
+    w.put(s);
+    return w;
+}
+
+inline RowWriter& operator<<(RowWriter& w, int v) {
+    w.putInt(v);
+    return w;
+}
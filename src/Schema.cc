@@ -18,28 +18,71 @@ limitations under the License.
 #include "Schema.h"
 
 #include "DbcTools.h"
+#include "Chunks.h"
+#include "Gzip.h"
+#include "LoadReport.h"
 #include "Log.h"
-
+#include "PgCopy.h"
+#include "Tables.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+#include <memory>
 #include <string>
-
-bool Schema::check(SQLHSTMT& hStmt, const char* query, int& cnt) {
-
-    SQLLEN nIdicator = 0;
-    SQLCHAR buf[128] = {0};
-
-    if (!DbcTools::executeServiceStatement(hStmt, query)) {
-        Log::l2() << Log::tm() << "-determine count failed\n";
-        return false;
-    }
-    if (!DbcTools::fetch(hStmt, buf, &nIdicator, 1, cnt)) {
-        Log::l2() << Log::tm() << "-determine count failed\n";
-        return false;
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+// Rows per warehouse of the warehouse-scoped tables, and rows of the others.
+static const int64_t expectedRows[tableCount] = {
+    1, 10, 30000, 30000, 9000, 30000, 300000, 100000, 100000, 62, 10000, 5};
+
+// Tables from largest to smallest, so that work spread over connections does
+// not leave ORDERLINE and STOCK for last, on their own, while the other
+// connections sit idle.
+static const Table bySize[tableCount] = {
+    Table::orderline, Table::stock,     Table::customer, Table::history,
+    Table::order,     Table::item,      Table::neworder, Table::supplier,
+    Table::district,  Table::warehouse, Table::nation,   Table::region};
+
+static const char* countQuery(Dialect* dialect, Table t) {
+    switch (t) {
+    case Table::warehouse:
+        return dialect->getSelectCountWarehouse();
+    case Table::district:
+        return dialect->getSelectCountDistrict();
+    case Table::customer:
+        return dialect->getSelectCountCustomer();
+    case Table::history:
+        return dialect->getSelectCountHistory();
+    case Table::neworder:
+        return dialect->getSelectCountNeworder();
+    case Table::order:
+        return dialect->getSelectCountOrder();
+    case Table::orderline:
+        return dialect->getSelectCountOrderline();
+    case Table::item:
+        return dialect->getSelectCountItem();
+    case Table::stock:
+        return dialect->getSelectCountStock();
+    case Table::nation:
+        return dialect->getSelectCountNation();
+    case Table::supplier:
+        return dialect->getSelectCountSupplier();
+    case Table::region:
+        return dialect->getSelectCountRegion();
     }
-    if (cnt == 0) {
-        Log::l2() << Log::tm() << "-determine count failed\n";
-        return false;
-    }
-    return true;
+    abort();
+}
+
+static std::string upper(const char* s) {
+    std::string u(s);
+    for (auto& c : u)
+        c = toupper(c);
+    return u;
 }
 
 bool Schema::createSchema(Dialect* dialect, SQLHSTMT& hStmt) {
@@ -63,7 +106,40 @@ bool Schema::createSchema(Dialect* dialect, SQLHSTMT& hStmt) {
     return true;
 }
 
-bool Schema::importCSV(Dialect* dialect, SQLHSTMT& hStmt, const std::string& genDir) {
+std::vector<std::string> Schema::importFiles(const std::string& genDir,
+                                             int table) {
+    // Each file may have been written gzip-compressed by gen --compress.
+    auto find = [](const std::string& path) -> std::string {
+        if (access(path.c_str(), F_OK) == 0)
+            return path;
+        if (access((path + gzipSuffix).c_str(), F_OK) == 0)
+            return path + gzipSuffix;
+        return "";
+    };
+
+    auto base = genDir + "/" + tableFileName(static_cast<Table>(table));
+    auto found = find(base);
+    if (!found.empty())
+        return {found};
+
+    // gen --jobs N writes the warehouse-scoped tables as numbered shards.
+    std::vector<std::string> shards;
+    for (int shard = 0;; shard++) {
+        auto path = find(base + shardSuffix(shard));
+        if (path.empty())
+            break;
+        shards.push_back(path);
+    }
+    // The files may only be visible to the database server, in which case
+    // we leave it to the server to report a missing file.
+    if (shards.empty())
+        return {base};
+    return shards;
+}
+
+bool Schema::importTasks(Dialect* dialect, const std::string& genDir,
+                         bool warehousesOnly, int partitions,
+                         std::vector<ImportTask>& tasks) {
 
     if (dialect->getImportPrefix().size() != dialect->getImportSuffix().size()) {
         Log::l2()
@@ -74,130 +150,537 @@ bool Schema::importCSV(Dialect* dialect, SQLHSTMT& hStmt, const std::string& gen
 
     for (size_t i = 0;
          i < dialect->getImportPrefix().size(); i++) {
-        if (!DbcTools::executeServiceStatement(
-                hStmt,
-                std::string(
-                    dialect->getImportPrefix()[i] +
-                    genDir +
-                    dialect->getImportSuffix()[i])
-                    .c_str())) {
-            Log::l2() << Log::tm() << "-failed\n";
+        auto t = static_cast<Table>(i);
+        if (warehousesOnly && !isWarehouseScoped(t))
+            continue;
+        auto files = importFiles(genDir, i);
+        bool partitioned = partitions && isWarehouseScoped(t);
+        if (partitioned && files.size() != static_cast<size_t>(partitions)) {
+            Log::l2() << Log::tm() << "-failed (" << tableName(t) << " has "
+                      << std::to_string(files.size()) << " shards for "
+                      << std::to_string(partitions) << " partitions)\n";
             return false;
         }
+        for (size_t k = 0; k < files.size(); k++) {
+            // Files that only the database server can see count as empty.
+            struct stat st;
+            off_t size = stat(files[k].c_str(), &st) == 0 ? st.st_size : 0;
+            tasks.push_back({static_cast<int>(i), std::move(files[k]), size,
+                             partitioned ? static_cast<int>(k) : -1});
+        }
     }
-
-    Log::l2() << Log::tm() << "-succeeded\n";
     return true;
 }
 
-bool Schema::check(Dialect* dialect, SQLHSTMT& hStmt) {
-    int wh = 0;
-    if (!check(hStmt, dialect->getSelectCountWarehouse(),
-               wh))
-        return false;
+// The name of the file at path, without its directory.
+static std::string baseName(const std::string& path) {
+    auto slash = path.rfind('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+std::string Schema::importStatement(Dialect* dialect, const ImportTask& task,
+                                    const std::string& path) {
+    auto t = static_cast<Table>(task.table);
+    if (task.partition >= 0)
+        return dialect->getPartitionImportPrefix(t, task.partition) + path +
+               dialect->getPartitionImportSuffix(t, task.partition);
+    return dialect->getImportPrefix()[task.table] + path +
+           dialect->getImportSuffix()[task.table];
+}
 
-    int ds = 0;
-    if (!check(hStmt, dialect->getSelectCountDistrict(),
-               ds))
+std::string Schema::copyStatement(Dialect* dialect, const ImportTask& task) {
+    if (task.partition >= 0) {
+        auto stmt = dialect->getPartitionCopyStatement(
+            static_cast<Table>(task.table), task.partition);
+        if (!stmt.empty())
+            return stmt;
+    }
+    return dialect->getCopyStatements()[task.table];
+}
+
+bool Schema::importFile(Dialect* dialect, SQLHSTMT& hStmt,
+                        const ImportTask& task, const char* copyUrl) {
+    Stopwatch watch;
+    int64_t rows = -1;
+    bool ok;
+    if (copyUrl) {
+        // COPY FROM STDIN reads the file on our side, compressed or not.
+        ok = PgCopy::copyFile(copyUrl, copyStatement(dialect, task).c_str(),
+                              task.file, rows);
+    } else {
+        // The import statements only read plain files, so compressed files
+        // are passed to them through a pipe that we decompress into while
+        // the database reads from it.
+        std::unique_ptr<GunzipPipe> pipe;
+        if (isGzipFile(task.file))
+            pipe.reset(new GunzipPipe(task.file));
+        const auto& path = pipe ? pipe->path() : task.file;
+        ok = DbcTools::executeServiceStatement(
+            hStmt, importStatement(dialect, task, path).c_str());
+        if (ok)
+            rows = DbcTools::rowCount(hStmt);
+        if (pipe && !pipe->finish())
+            ok = false;
+    }
+    if (ok)
+        LoadReport::add({"import", baseName(task.file), watch.seconds(), rows,
+                         task.size});
+    return ok;
+}
+
+bool Schema::importChunks(Dialect* dialect, SQLHDBC& hDBC, SQLHSTMT& hStmt,
+                          const ImportTask& task, int chunkRows,
+                          const char* copyUrl) {
+    // Progress is recorded by file name rather than path, and as the chunks
+    // of a file are committed in order, the recorded ones are its first.
+    Stopwatch watch;
+    auto name = baseName(task.file);
+    int64_t progress[3] = {0, 0, 0};
+    auto select = dialect->getSelectProgressPrefix() + name + "'";
+    if (!DbcTools::executeServiceStatement(hStmt, select.c_str()) ||
+        !DbcTools::fetch(hStmt, progress, 3))
         return false;
-    if (ds != 10 * wh) {
-        Log::l2() << Log::tm() << "-check failed (#DISTRICT: " << ds << ")\n";
+    int64_t done = progress[0];
+    if (done > 0 && (progress[1] != chunkRows || progress[2] != chunkRows)) {
+        Log::l2() << Log::tm() << "-" << name
+                  << " was partly loaded with a different chunk size\n";
         return false;
     }
 
-    int cs = 0;
-    if (!check(hStmt, dialect->getSelectCountCustomer(),
-               cs))
-        return false;
-    if (cs != 30000 * wh) {
-        Log::l2() << Log::tm() << "-check failed (#CUSTOMER: " << cs << ")\n";
+    ChunkReader reader(task.file, chunkRows);
+    for (int64_t k = 0; k < done; k++) {
+        if (!reader.skip())
+            return false;
+    }
+    if (done > 0)
+        Log::l2() << Log::tm() << "-resuming " << name << " after "
+                  << std::to_string(done) << " chunks\n";
+
+    // Each chunk is loaded in a transaction of its own, which also records
+    // it, so that it is either loaded and recorded or neither. COPY FROM
+    // STDIN runs over a libpq connection, which records it as well.
+    std::unique_ptr<PgCopy> copy;
+    if (copyUrl) {
+        copy.reset(new PgCopy(copyUrl));
+        if (!copy->connected())
+            return false;
+    } else if (!DbcTools::autoCommitOff(hDBC)) {
         return false;
     }
 
-    int od = 0;
-    if (!check(hStmt, dialect->getSelectCountOrder(),
-               od))
+    int64_t rows = 0;
+    for (int64_t k = done; !reader.done(); k++) {
+        auto record = dialect->getInsertProgressPrefix() + name + "', " +
+                      std::to_string(k) + ", " + std::to_string(chunkRows) +
+                      ")";
+        bool ok;
+        if (copy) {
+            ok = copy->exec("BEGIN") &&
+                 copy->start(copyStatement(dialect, task).c_str()) &&
+                 reader.next([&](const char* data, size_t len) {
+                     return copy->put(data, len);
+                 });
+            ok = copy->end() && ok;
+            ok = ok && copy->exec(record) && copy->exec("COMMIT");
+            if (ok)
+                rows += copy->rows();
+            else
+                copy->exec("ROLLBACK");
+        } else {
+            ChunkPipe pipe(reader, task.file + ".fifo");
+            ok = DbcTools::executeServiceStatement(
+                hStmt, importStatement(dialect, task, pipe.path()).c_str());
+            ok = pipe.finish() && ok;
+            int64_t chunk = ok ? DbcTools::rowCount(hStmt) : -1;
+            ok = ok && DbcTools::executeServiceStatement(hStmt, record.c_str()) &&
+                 DbcTools::commit(hDBC);
+            if (ok && chunk >= 0 && rows >= 0)
+                rows += chunk;
+            else
+                rows = -1;
+            if (!ok)
+                DbcTools::rollback(hDBC);
+        }
+        if (!ok)
+            return false;
+    }
+    if (!reader.ok())
         return false;
-    if (od != 30000 * wh) {
-        Log::l2() << Log::tm() << "-check failed (#ORDER: " << od << ")\n";
+    LoadReport::add({"import", name, watch.seconds(), rows, task.size});
+    return true;
+}
+
+bool Schema::importCSV(Dialect* dialect, SQLHSTMT& hStmt,
+                       const std::string& genDir, bool warehousesOnly,
+                       int partitions) {
+
+    std::vector<ImportTask> tasks;
+    if (!importTasks(dialect, genDir, warehousesOnly, partitions, tasks))
         return false;
+
+    for (const auto& task : tasks) {
+        if (!importFile(dialect, hStmt, task, nullptr)) {
+            Log::l2() << Log::tm() << "-failed\n";
+            return false;
+        }
     }
 
-    int ol = 0;
-    if (!check(hStmt, dialect->getSelectCountOrderline(),
-               ol))
+    Log::l2() << Log::tm() << "-succeeded\n";
+    return true;
+}
+
+bool Schema::importCSV(Dialect* dialect, const LoadTarget& target,
+                       const std::string& genDir, int loadJobs,
+                       bool warehousesOnly, int chunkRows, int partitions,
+                       std::atomic<bool>* failed) {
+
+    std::vector<ImportTask> tasks;
+    if (!importTasks(dialect, genDir, warehousesOnly, partitions, tasks))
         return false;
-    if (ol != 300000 * wh) {
-        Log::l2() << Log::tm() << "-check failed (#ORDERLINE: " << ol << ")\n";
+
+    // Starting with the largest files keeps ORDERLINE and STOCK from being
+    // loaded last, on their own, while the other connections sit idle.
+    std::stable_sort(tasks.begin(), tasks.end(),
+                     [](const ImportTask& a, const ImportTask& b) {
+                         return a.size > b.size;
+                     });
+
+    size_t jobs = std::min(static_cast<size_t>(loadJobs), tasks.size());
+    if (!runParallel(target, jobs, tasks.size(),
+                     [&](SQLHDBC& hDBC, SQLHSTMT& hStmt, size_t i) {
+                         if (chunkRows)
+                             return importChunks(dialect, hDBC, hStmt,
+                                                 tasks[i], chunkRows,
+                                                 target.copyUrl);
+                         return importFile(dialect, hStmt, tasks[i], target.copyUrl);
+                     },
+                     failed)) {
+        Log::l2() << Log::tm() << "-failed\n";
         return false;
     }
 
-    int no = 0;
-    if (!check(hStmt, dialect->getSelectCountNeworder(),
-               no))
-        return false;
-    if (no != 9000 * wh) {
-        Log::l2() << Log::tm() << "-check failed (#NEWORDER: " << no << ")\n";
+    // The chunks of a complete import need not be skipped by the next one,
+    // e.g. of appended warehouses into files of the same names.
+    if (chunkRows &&
+        !runParallel(target, 1, 1, [&](SQLHDBC&, SQLHSTMT& hStmt, size_t) {
+            return DbcTools::executeServiceStatement(
+                hStmt, dialect->getDeleteProgress());
+        })) {
+        Log::l2() << Log::tm() << "-failed\n";
         return false;
     }
+    Log::l2() << Log::tm() << "-succeeded with " << std::to_string(jobs)
+              << " connections\n";
+    return true;
+}
+
+bool Schema::partition(Dialect* dialect, SQLHSTMT& hStmt,
+                       const std::vector<int>& lastWarehouses) {
+    for (int i = 0; i < tableCount; i++) {
+        auto t = static_cast<Table>(i);
+        if (!isWarehouseScoped(t))
+            continue;
+        for (const auto& stmt :
+             dialect->getPartitionStatements(t, lastWarehouses)) {
+            if (!DbcTools::executeServiceStatement(hStmt, stmt.c_str())) {
+                Log::l2() << Log::tm() << "-failed\n";
+                return false;
+            }
+        }
+    }
+    Log::l2() << Log::tm() << "-succeeded with "
+              << std::to_string(lastWarehouses.size()) << " partitions\n";
+    return true;
+}
+
+bool Schema::runParallel(
+    const LoadTarget& target, size_t jobs, size_t tasks,
+    const std::function<bool(SQLHDBC&, SQLHSTMT&, size_t)>& task,
+    std::atomic<bool>* sharedFailed) {
+    std::atomic<size_t> next{0};
+    std::atomic<bool> ownFailed{false};
+    std::atomic<bool>& failed = sharedFailed ? *sharedFailed : ownFailed;
+    auto work = [&]() {
+        SQLHENV hEnv = target.hEnv;
+        SQLHDBC hDBC = nullptr;
+        if (!DbcTools::connect(hEnv, hDBC, target.dsn,
+                               target.username, target.password)) {
+            if (hDBC)
+                SQLFreeHandle(SQL_HANDLE_DBC, hDBC);
+            failed = true;
+            return;
+        }
+        SQLHSTMT hStmt = nullptr;
+        SQLAllocHandle(SQL_HANDLE_STMT, hDBC, &hStmt);
+
+        size_t i;
+        while (!failed && (i = next++) < tasks) {
+            if (!task(hDBC, hStmt, i))
+                failed = true;
+        }
+
+        SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+        SQLDisconnect(hDBC);
+        SQLFreeHandle(SQL_HANDLE_DBC, hDBC);
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t j = 0; j < jobs; j++)
+        threads.emplace_back(work);
+    for (auto& t : threads)
+        t.join();
+    return !failed;
+}
+
+bool Schema::executeStatements(SQLHSTMT& hStmt,
+                               const std::vector<const char*>& stmts) {
+    for (const char* stmt : stmts) {
+        if (!DbcTools::executeServiceStatement(hStmt, stmt))
+            return false;
+    }
+    return true;
+}
 
-    int hs = 0;
-    if (!check(hStmt, dialect->getSelectCountHistory(),
-               hs))
+bool Schema::indexTable(Dialect* dialect, SQLHSTMT& hStmt, size_t table) {
+    Stopwatch watch;
+    if (!executeStatements(hStmt, dialect->getCreateIndexStatements()[table]))
         return false;
-    if (hs != 30000 * wh) {
-        Log::l2() << Log::tm() << "-check failed (#HISTORY: " << hs << ")\n";
+    LoadReport::add({"index", tableName(static_cast<Table>(table)),
+                     watch.seconds()});
+    return true;
+}
+
+bool Schema::createIndexes(Dialect* dialect, SQLHSTMT& hStmt) {
+
+    for (size_t i = 0; i < dialect->getCreateIndexStatements().size(); i++) {
+        if (!indexTable(dialect, hStmt, i)) {
+            Log::l2() << Log::tm() << "-failed\n";
+            return false;
+        }
+    }
+
+    Log::l2() << Log::tm() << "-succeeded\n";
+    return true;
+}
+
+bool Schema::createIndexes(Dialect* dialect, const LoadTarget& target,
+                           int jobs) {
+
+    auto& tables = dialect->getCreateIndexStatements();
+    std::vector<size_t> tasks;
+    for (Table t : bySize) {
+        auto i = static_cast<size_t>(t);
+        if (i < tables.size() && !tables[i].empty())
+            tasks.push_back(i);
+    }
+
+    size_t n = std::min(static_cast<size_t>(jobs), tasks.size());
+    if (!runParallel(target, n, tasks.size(),
+                     [&](SQLHDBC&, SQLHSTMT& hStmt, size_t i) {
+                         return indexTable(dialect, hStmt, tasks[i]);
+                     })) {
+        Log::l2() << Log::tm() << "-failed\n";
         return false;
     }
+    Log::l2() << Log::tm() << "-succeeded with " << std::to_string(n)
+              << " connections\n";
+    return true;
+}
+
+bool Schema::checkQuery(Dialect* dialect, SQLHSTMT& hStmt, int query,
+                        bool deep, TableSummary& found) {
+    const char* stmt;
+    int columns = 1;
+    if (query == tableCount) {
+        stmt = dialect->getSelectMaxWarehouse();
+    } else if (deep) {
+        stmt = dialect->getChecksumStatements()[query];
+        columns = 2;
+    } else {
+        stmt = countQuery(dialect, static_cast<Table>(query));
+    }
 
-    int st = 0;
-    if (!check(hStmt, dialect->getSelectCountStock(),
-               st))
+    Stopwatch watch;
+    int64_t values[2] = {0, 0};
+    if (!DbcTools::executeServiceStatement(hStmt, stmt) ||
+        !DbcTools::fetch(hStmt, values, columns)) {
+        Log::l2() << Log::tm() << "-determine count failed\n";
         return false;
-    if (st != 100000 * wh) {
-        Log::l2() << Log::tm() << "-check failed (#STOCK: " << st << ")\n";
+    }
+    found.rows = values[0];
+    found.checksum = values[1];
+    if (query < tableCount)
+        LoadReport::add({"check", tableName(static_cast<Table>(query)),
+                         watch.seconds(), found.rows});
+    return true;
+}
+
+bool Schema::verify(const TableSummary* found, const Manifest* manifest) {
+    int64_t wh = found[static_cast<int>(Table::warehouse)].rows;
+    if (wh == 0) {
+        Log::l2() << Log::tm() << "-check failed (#WAREHOUSE: 0)\n";
         return false;
     }
 
-    int it = 0;
-    if (!check(hStmt, dialect->getSelectCountItem(), it))
+    // Appending warehouses must extend the range 1..wh without gaps.
+    int64_t maxWh = found[tableCount].rows;
+    if (maxWh != wh) {
+        Log::l2() << Log::tm() << "-check failed (max W_ID: "
+                  << std::to_string(maxWh) << ", #WAREHOUSE: "
+                  << std::to_string(wh) << ")\n";
         return false;
-    if (it != 100000) {
-        Log::l2() << Log::tm() << "-check failed (#ITEM: " << it << ")\n";
+    }
+
+    for (int i = 0; i < tableCount; i++) {
+        auto t = static_cast<Table>(i);
+        int64_t expected = expectedRows[i] * (isWarehouseScoped(t) ? wh : 1);
+        if (found[i].rows != expected) {
+            Log::l2() << Log::tm() << "-check failed (#"
+                      << upper(tableName(t)) << ": "
+                      << std::to_string(found[i].rows) << ")\n";
+            return false;
+        }
+    }
+
+    if (!manifest) {
+        Log::l2() << Log::tm() << "-check with " << std::to_string(wh)
+                  << " warehouses succeeded\n";
+        return true;
+    }
+
+    if (manifest->firstWarehouse != 1 || manifest->lastWarehouse != wh) {
+        Log::l2() << Log::tm() << "-check failed (manifest is for warehouses "
+                  << std::to_string(manifest->firstWarehouse) << ".."
+                  << std::to_string(manifest->lastWarehouse) << ")\n";
         return false;
     }
+    for (int i = 0; i < tableCount; i++) {
+        if (found[i] != manifest->tables[i]) {
+            Log::l2() << Log::tm() << "-check failed (checksum of "
+                      << upper(tableName(static_cast<Table>(i))) << ": "
+                      << std::to_string(found[i].checksum) << ", expected "
+                      << std::to_string(manifest->tables[i].checksum)
+                      << ")\n";
+            return false;
+        }
+    }
+    Log::l2() << Log::tm() << "-check with " << std::to_string(wh)
+              << " warehouses and checksums succeeded\n";
+    return true;
+}
+
+bool Schema::check(Dialect* dialect, SQLHSTMT& hStmt,
+                   const Manifest* manifest) {
+    TableSummary found[tableCount + 1];
+    for (int q = 0; q <= tableCount; q++) {
+        if (!checkQuery(dialect, hStmt, q, manifest, found[q]))
+            return false;
+    }
+    return verify(found, manifest);
+}
 
-    int sp = 0;
-    if (!check(hStmt, dialect->getSelectCountSupplier(),
-               sp))
+bool Schema::check(Dialect* dialect, const LoadTarget& target, int jobs,
+                   const Manifest* manifest) {
+    // The highest warehouse id comes last, after the counts by table size.
+    std::vector<int> queries;
+    for (Table t : bySize)
+        queries.push_back(static_cast<int>(t));
+    queries.push_back(tableCount);
+
+    TableSummary found[tableCount + 1];
+    size_t n = std::min(static_cast<size_t>(jobs), queries.size());
+    if (!runParallel(target, n, queries.size(),
+                     [&](SQLHDBC&, SQLHSTMT& hStmt, size_t i) {
+                         return checkQuery(dialect, hStmt, queries[i],
+                                           manifest, found[queries[i]]);
+                     }))
         return false;
-    if (sp != 10000) {
-        Log::l2() << Log::tm() << "-check failed (#SUPPLIER: " << sp << ")\n";
+    return verify(found, manifest);
+}
+
+bool Schema::snapshot(Dialect* dialect, SQLHSTMT& hStmt) {
+
+    for (const char* stmt : dialect->getDropSnapshotStatements()) {
+        DbcTools::executeServiceStatement(hStmt, stmt, false);
+    }
+
+    if (!executeStatements(hStmt, dialect->getSnapshotStatements())) {
+        Log::l2() << Log::tm() << "-failed\n";
         return false;
     }
 
-    int na = 0;
-    if (!check(hStmt, dialect->getSelectCountNation(),
-               na))
+    Log::l2() << Log::tm() << "-succeeded\n";
+    return true;
+}
+
+bool Schema::restore(Dialect* dialect, SQLHDBC& hDBC, SQLHSTMT& hStmt) {
+
+    // A database that gen --load or a run without --reset loaded has no
+    // snapshot, and the tables must not be emptied before that is known.
+    for (const char* stmt : dialect->getSnapshotCheckStatements()) {
+        if (!DbcTools::executeServiceStatement(hStmt, stmt)) {
+            Log::l2() << Log::tm() << "-no complete snapshot, load with "
+                      << "run --reset to take one\n";
+            return false;
+        }
+    }
+
+    bool transactional = dialect->isRestoreTransactional();
+    if (transactional && !DbcTools::autoCommitOff(hDBC)) {
+        Log::l2() << Log::tm() << "-failed\n";
         return false;
-    if (na != 62) {
-        Log::l2() << Log::tm() << "-check failed (#NATION: " << na << ")\n";
+    }
+    bool ok = executeStatements(hStmt, dialect->getRestoreStatements());
+    if (transactional) {
+        if (ok)
+            ok = DbcTools::commit(hDBC);
+        else
+            DbcTools::rollback(hDBC);
+        ok = DbcTools::autoCommitOn(hDBC) && ok;
+    }
+    if (!ok) {
+        Log::l2() << Log::tm() << "-failed\n";
         return false;
     }
 
-    int rg = 0;
-    if (!check(hStmt, dialect->getSelectCountRegion(),
-               rg))
+    Log::l2() << Log::tm() << "-succeeded\n";
+    return true;
+}
+
+bool Schema::matchesFingerprint(Dialect* dialect, SQLHSTMT& hStmt,
+                                const std::string& digest) {
+    // A database from before the fingerprint table, or one whose
+    // fingerprint was cleared, holds no row and does not match.
+    SQLCHAR buf[1024] = {0};
+    SQLLEN nIdicator = 0;
+    std::string found;
+    if (!DbcTools::executeServiceStatement(
+            hStmt, dialect->getSelectFingerprint(), false) ||
+        !DbcTools::fetch(hStmt, buf, &nIdicator, 1, found)) {
+        Log::l2() << Log::tm() << "-no fingerprint\n";
         return false;
-    if (rg != 5) {
-        Log::l2() << Log::tm() << "-check failed (#REGION: " << rg << ")\n";
+    }
+    if (found != digest) {
+        Log::l2() << Log::tm() << "-fingerprint " << found
+                  << " does not match manifest " << digest << "\n";
         return false;
     }
-
-    Log::l2() << Log::tm() << "-check with " << wh << " warehouses succeeded\n";
+    Log::l2() << Log::tm() << "-fingerprint " << digest << " matches\n";
     return true;
 }
 
+bool Schema::writeFingerprint(Dialect* dialect, SQLHSTMT& hStmt,
+                              const std::string& digest) {
+    if (!DbcTools::executeServiceStatement(hStmt,
+                                           dialect->getDeleteFingerprint()))
+        return false;
+    if (digest.empty())
+        return true;
+    std::string insert =
+        std::string(dialect->getInsertFingerprintPrefix()) + digest + "')";
+    return DbcTools::executeServiceStatement(hStmt, insert.c_str());
+}
+
 bool Schema::additionalPreparation(Dialect* dialect, SQLHSTMT& hStmt) {
 
     for (auto stmt: dialect
@@ -18,22 +18,133 @@ limitations under the License.
 #ifndef SCHEMA_H
 #define SCHEMA_H
 
+#include "DbcTools.h"
 #include "Dialect.h"
+#include "Manifest.h"
 
+#include <atomic>
+#include <functional>
 #include <sql.h>
 #include <sqlext.h>
 #include <sqltypes.h>
 #include <string>
+#include <sys/types.h>
+#include <vector>
 
 class Schema {
 
   private:
-    static bool check(SQLHSTMT& hStmt, const char* query, int& cnt);
+    // A file to load with the table'th import statement of the dialect, or
+    // into the partition'th partition of the table if that is not -1.
+    struct ImportTask {
+        int table;
+        std::string file;
+        off_t size;
+        int partition;
+    };
+
+    // Runs the table'th count query, or with deep its checksum query, or
+    // for table == tableCount the query for the highest warehouse id.
+    static bool checkQuery(Dialect* dialect, SQLHSTMT& hStmt, int table,
+                           bool deep, TableSummary& found);
+    // Checks what the queries found, indexed as above.
+    static bool verify(const TableSummary* found, const Manifest* manifest);
+    // Files to import for the table'th import statement of the dialect.
+    static std::vector<std::string> importFiles(const std::string& genDir,
+                                                int table);
+    // With partitions set, the shards of the warehouse-scoped tables are
+    // loaded into the partitions of the same number.
+    static bool importTasks(Dialect* dialect, const std::string& genDir,
+                            bool warehousesOnly, int partitions,
+                            std::vector<ImportTask>& tasks);
+    // The import statement that reads the task's rows from path, and the
+    // COPY FROM STDIN statement that loads them.
+    static std::string importStatement(Dialect* dialect,
+                                       const ImportTask& task,
+                                       const std::string& path);
+    static std::string copyStatement(Dialect* dialect, const ImportTask& task);
+    // Imports with the dialect's import statement, or with its COPY
+    // statement over libpq if copyUrl is set.
+    static bool importFile(Dialect* dialect, SQLHSTMT& hStmt,
+                           const ImportTask& task, const char* copyUrl);
+    // Imports the file in chunks of chunkRows rows, each committed together
+    // with its record in the load progress table, skipping the chunks that
+    // are recorded already. Turns autocommit off on hDBC.
+    static bool importChunks(Dialect* dialect, SQLHDBC& hDBC, SQLHSTMT& hStmt,
+                             const ImportTask& task, int chunkRows,
+                             const char* copyUrl);
+    static bool executeStatements(SQLHSTMT& hStmt,
+                                  const std::vector<const char*>& stmts);
+    // Creates the keys and indexes of the table'th list of the dialect.
+    static bool indexTable(Dialect* dialect, SQLHSTMT& hStmt, size_t table);
+    // Runs task(hDBC, hStmt, i) for i in [0, tasks) over jobs connections of
+    // their own, each taking the next i when done with the last one. A
+    // failure sets failed, if given, and setting it stops the tasks.
+    static bool
+    runParallel(const LoadTarget& target, size_t jobs, size_t tasks,
+                const std::function<bool(SQLHDBC&, SQLHSTMT&, size_t)>& task,
+                std::atomic<bool>* failed = nullptr);
 
   public:
     static bool createSchema(Dialect* dialect, SQLHSTMT& hStmt);
-    static bool importCSV(Dialect* dialect, SQLHSTMT& hStmt, const std::string& genDir);
-    static bool check(Dialect* dialect, SQLHSTMT& hStmt);
+    // Imports the tables generated into genDir. With warehousesOnly, only
+    // the warehouse-scoped tables are imported, which appends the warehouses
+    // of a gen --from-warehouse run to an existing database.
+    // With partitions, the tables are partitioned like the shards of gen
+    // --partitions, and every shard is loaded into its partition directly
+    // where the dialect allows that.
+    static bool importCSV(Dialect* dialect, SQLHSTMT& hStmt,
+                          const std::string& genDir,
+                          bool warehousesOnly = false, int partitions = 0);
+    // Imports as above over loadJobs connections of their own, each loading
+    // one file at a time, largest files first. Shards of the same table are
+    // loaded concurrently too. With target.copyUrl set, the files are
+    // streamed with COPY FROM STDIN instead.
+    // With chunkRows set, every file is loaded in chunks of that many rows,
+    // each in a transaction of its own, and an import that failed resumes
+    // after the last committed chunk.
+    // A failed import sets failed, if given, so that whatever feeds the
+    // files through pipes stops waiting for them to be read; setting it
+    // fails the import.
+    static bool importCSV(Dialect* dialect, const LoadTarget& target,
+                          const std::string& genDir, int loadJobs,
+                          bool warehousesOnly = false, int chunkRows = 0,
+                          int partitions = 0,
+                          std::atomic<bool>* failed = nullptr);
+    // Partitions the empty warehouse-scoped tables by ranges of warehouse
+    // ids, the p'th ending with warehouse lastWarehouses[p].
+    static bool partition(Dialect* dialect, SQLHSTMT& hStmt,
+                          const std::vector<int>& lastWarehouses);
+    // Creates the primary keys and indexes once the tables are loaded, which
+    // builds them from sorted runs instead of maintaining them row by row.
+    static bool createIndexes(Dialect* dialect, SQLHSTMT& hStmt);
+    // Creates them as above over jobs connections of their own, one table
+    // per connection at a time, largest tables first.
+    static bool createIndexes(Dialect* dialect, const LoadTarget& target,
+                              int jobs);
+    // Checks the row counts of all tables against the warehouse count. With
+    // a manifest, also checks the tables' checksums against it, which the
+    // same scan of each table computes.
+    static bool check(Dialect* dialect, SQLHSTMT& hStmt,
+                      const Manifest* manifest = nullptr);
+    // Checks as above over jobs connections of their own, largest tables
+    // first.
+    static bool check(Dialect* dialect, const LoadTarget& target, int jobs,
+                      const Manifest* manifest = nullptr);
+    // Replaces the snapshot of the tables that the transactions modify with
+    // their current contents.
+    static bool snapshot(Dialect* dialect, SQLHSTMT& hStmt);
+    // Resets the tables that the transactions modify to the snapshot, in a
+    // single transaction where the dialect allows that. Fails without
+    // touching the tables if a table of the snapshot is missing.
+    static bool restore(Dialect* dialect, SQLHDBC& hDBC, SQLHSTMT& hStmt);
+    // Returns whether the fingerprint table holds digest, the digest of a
+    // manifest, i.e. whether the database still holds that dataset.
+    static bool matchesFingerprint(Dialect* dialect, SQLHSTMT& hStmt,
+                                   const std::string& digest);
+    // Replaces the fingerprint with digest, or clears it if digest is empty.
+    static bool writeFingerprint(Dialect* dialect, SQLHSTMT& hStmt,
+                                 const std::string& digest);
     static bool additionalPreparation(Dialect* dialect, SQLHSTMT& hStmt);
 };
 
@@ -0,0 +1,141 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// The twelve CH-benCHmark tables, in the order in which the dialects list
+// their import statements.
+enum class Table {
+    warehouse,
+    district,
+    customer,
+    history,
+    neworder,
+    order,
+    orderline,
+    item,
+    stock,
+    nation,
+    supplier,
+    region,
+};
+
+constexpr int tableCount = 12;
+
+inline const char* tableName(Table t) {
+    static const char* names[tableCount] = {
+        "warehouse", "district", "customer", "history",
+        "neworder",  "order",    "orderline", "item",
+        "stock",     "nation",   "supplier",  "region"};
+    return names[static_cast<int>(t)];
+}
+
+// Name of the file that gen writes for the table, relative to its output
+// directory.
+inline std::string tableFileName(Table t) {
+    return std::string(tableName(t)) + ".tbl";
+}
+
+// Suffix appended to a table's file name when gen shards the warehouse range
+// into partitions, e.g. "orderline.tbl.07".
+inline std::string shardSuffix(int shard) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), ".%02d", shard);
+    return buf;
+}
+
+// Whether the table's cardinality scales with the number of warehouses.
+// ITEM, NATION, SUPPLIER and REGION are fixed-size and generated once.
+inline bool isWarehouseScoped(Table t) {
+    switch (t) {
+    case Table::item:
+    case Table::nation:
+    case Table::supplier:
+    case Table::region:
+        return false;
+    default:
+        return true;
+    }
+}
+
+// Column of a warehouse-scoped table that holds the warehouse id, by which
+// run --partition partitions it.
+inline const char* warehouseColumnName(Table t) {
+    switch (t) {
+    case Table::warehouse:
+        return "w_id";
+    case Table::district:
+        return "d_w_id";
+    case Table::customer:
+        return "c_w_id";
+    case Table::history:
+        return "h_w_id";
+    case Table::neworder:
+        return "no_w_id";
+    case Table::order:
+        return "o_w_id";
+    case Table::orderline:
+        return "ol_w_id";
+    case Table::stock:
+        return "s_w_id";
+    default:
+        return nullptr;
+    }
+}
+
+// The last warehouse of each of n contiguous partitions of the warehouses
+// [first, last], which differ in size by at most one. gen writes each
+// partition as a shard of its own.
+inline std::vector<int> partitionBounds(int first, int last, int n) {
+    std::vector<int> bounds;
+    int count = last - first + 1;
+    for (int p = 0; p < n; p++) {
+        first += count / n + (p < count % n);
+        bounds.push_back(first - 1);
+    }
+    return bounds;
+}
+
+// Field of the table whose sum makes up its checksum in the manifest that
+// gen writes, counting from 0. Where the table has one, this is a random
+// column rather than part of the key, so that the checksum also tells apart
+// data generated with different seeds. O_C_ID is not: every district has
+// each customer's order once. An empty O_CARRIER_ID counts as 0, as its NULL
+// does not count in the database's sum.
+inline int checksumField(Table t) {
+    switch (t) {
+    case Table::customer:
+        return 21; // C_N_NATIONKEY
+    case Table::order:
+        return 5; // O_CARRIER_ID
+    case Table::orderline:
+        return 4; // OL_I_ID
+    case Table::item:
+        return 1; // I_IM_ID
+    case Table::stock:
+        return 2; // S_QUANTITY
+    case Table::nation:
+        return 2; // N_REGIONKEY
+    case Table::supplier:
+        return 3; // SU_NATIONKEY
+    default:
+        return 0; // W_ID, D_ID, H_C_ID, NO_O_ID, R_REGIONKEY
+    }
+}
@@ -0,0 +1,110 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "Terminals.h"
+
+#include "Random.h"
+
+#include <algorithm>
+#include <thread>
+
+Pacing Pacing::closedLoop(unsigned sleepMin, unsigned sleepMax) {
+    Pacing p;
+    p.sleepMin = sleepMin;
+    p.sleepMax = sleepMax;
+    return p;
+}
+
+Pacing Pacing::openLoop(double perSecond, bool poisson) {
+    Pacing p;
+    p.interarrival = 1 / perSecond;
+    p.poisson = poisson;
+    return p;
+}
+
+Pacing Pacing::terminals(const TransactionTimes& keying,
+                         const TransactionTimes& think) {
+    Pacing p;
+    p.terminalModel = true;
+    p.keying = keying;
+    p.think = think;
+    return p;
+}
+
+static Terminal::time_point::duration seconds(double s) {
+    return std::chrono::duration_cast<Terminal::time_point::duration>(
+        std::chrono::duration<double>(s));
+}
+
+Terminal::time_point::duration Pacing::arrivalGap() const {
+    if (!poisson)
+        return seconds(interarrival);
+    return seconds(
+        std::exponential_distribution<double>(1 / interarrival)(chRandom::rng));
+}
+
+Terminal::time_point Pacing::first(const Terminal& t,
+                                   Terminal::time_point now) const {
+    if (terminalModel)
+        return now + seconds(keying[t.transaction - 1]);
+    if (!interarrival)
+        return now;
+    if (poisson)
+        return now + arrivalGap();
+    return now + seconds(std::uniform_real_distribution<double>(
+                     0, interarrival)(chRandom::rng));
+}
+
+Terminal::time_point Pacing::next(const Terminal& t, int finished,
+                                  Terminal::time_point now) const {
+    if (terminalModel) {
+        double mean = think[finished - 1];
+        double thought =
+            mean > 0 ? std::min(std::exponential_distribution<double>(
+                                    1 / mean)(chRandom::rng),
+                                10 * mean)
+                     : 0;
+        return now + seconds(thought) + seconds(keying[t.transaction - 1]);
+    }
+    if (!interarrival)
+        return now + std::chrono::microseconds(
+                         chRandom::uniformInt(sleepMin, sleepMax));
+    return t.due + arrivalGap();
+}
+
+constexpr std::chrono::milliseconds TerminalQueue::pollInterval;
+
+bool TerminalQueue::next(Terminal& t, const std::function<bool()>& stop) {
+    while (!queue.empty() && !stop()) {
+        auto wait = queue.top().due - std::chrono::steady_clock::now();
+        if (wait <= wait.zero()) {
+            t = queue.top();
+            queue.pop();
+            return true;
+        }
+        std::this_thread::sleep_for(
+            std::min<std::chrono::steady_clock::duration>(wait, pollInterval));
+    }
+    return false;
+}
+
+std::vector<Terminal> TerminalQueue::takeAll() {
+    std::vector<Terminal> all;
+    all.reserve(queue.size());
+    for (; !queue.empty(); queue.pop())
+        all.push_back(queue.top());
+    return all;
+}
@@ -0,0 +1,109 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// A logical terminal of the transactional workload. Between transactions it
+// only holds the state it resumes from: when it is due to run its next one,
+// and which one that is.
+struct Terminal {
+    using time_point = std::chrono::steady_clock::time_point;
+
+    int id;
+    time_point due;
+    // home warehouse and district, or 0 for random ones per transaction
+    int wId = 0;
+    int dId = 0;
+    // 1 NewOrder, 2 Payment, 3 OrderStatus, 4 Delivery, 5 StockLevel
+    int transaction = 0;
+};
+
+// Seconds per transaction type, indexed by Terminal::transaction - 1.
+using TransactionTimes = std::array<double, 5>;
+
+// When a terminal's transactions are due. In the closed loop, each is due a
+// random sleep after the last one finished. At a target rate, they arrive
+// on a schedule of their own, at fixed intervals or as a Poisson process,
+// each due an interarrival time after the last one was due, however late
+// that one ran. A stalling database then builds up a backlog of overdue
+// transactions rather than lowering the offered load, and latency measured
+// from when a transaction was due includes the time it waited.
+//
+// In the TPC-C terminal model (5.2.5), a terminal thinks about the result of
+// its last transaction for a negative-exponential time, truncated at ten
+// times its mean, then keys in the next one for a fixed time, and the
+// transaction is due once it is keyed in. Both times depend on the type.
+class Pacing {
+    unsigned sleepMin = 0;
+    unsigned sleepMax = 0;
+    // mean seconds between arrivals, 0 in the closed loop
+    double interarrival = 0;
+    bool poisson = true;
+    bool terminalModel = false;
+    TransactionTimes keying = {};
+    TransactionTimes think = {};
+
+    Terminal::time_point::duration arrivalGap() const;
+
+  public:
+    // Sleeps between sleepMin and sleepMax microseconds.
+    static Pacing closedLoop(unsigned sleepMin, unsigned sleepMax);
+    // Arrivals at perSecond on average.
+    static Pacing openLoop(double perSecond, bool poisson);
+    // Keying and mean think times of the terminal model.
+    static Pacing terminals(const TransactionTimes& keying,
+                            const TransactionTimes& think);
+
+    // When a terminal that starts at now is first due. Arrivals start at a
+    // random offset, so that the terminals do not arrive in lockstep.
+    Terminal::time_point first(const Terminal& t,
+                               Terminal::time_point now) const;
+    // When t is due next, having finished a transaction of type finished at
+    // now, with t.transaction already chosen.
+    Terminal::time_point next(const Terminal& t, int finished,
+                              Terminal::time_point now) const;
+};
+
+// The terminals that one transactional thread serves over its connection.
+// The thread is an event loop that runs whichever terminal is due first and
+// then reschedules it, so that a few connections serve thousands of
+// terminals that spend most of their time waiting.
+class TerminalQueue {
+    struct Later {
+        bool operator()(const Terminal& a, const Terminal& b) const {
+            return a.due > b.due;
+        }
+    };
+    std::priority_queue<Terminal, std::vector<Terminal>, Later> queue;
+
+  public:
+    // How often a thread waiting for its next terminal checks whether to stop.
+    static constexpr std::chrono::milliseconds pollInterval{100};
+
+    void schedule(const Terminal& t) { queue.push(t); }
+    size_t size() const { return queue.size(); }
+    // Removes all terminals, in no particular order.
+    std::vector<Terminal> takeAll();
+    // Takes the terminal that is due first, once it is due. Returns false if
+    // there is none, or if stop returns true first.
+    bool next(Terminal& t, const std::function<bool()>& stop);
+};
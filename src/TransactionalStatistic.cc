@@ -26,13 +26,36 @@ TransactionalStatistic::TransactionalStatistic() {
 
 void TransactionalStatistic::addResult(
     unsigned long long& transcationalResults) {
+    std::lock_guard<std::mutex> lock(mutex);
     transcationalResults += executeTPCCSuccessCount[0];
 }
 
 void TransactionalStatistic::executeTPCCSuccess(int transactionNumber,
-                                                bool success) {
-    if (success)
+                                                bool success,
+                                                uint64_t latencyNanos) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (success) {
         executeTPCCSuccessCount[transactionNumber - 1]++;
-    else
+        latencies[transactionNumber - 1].record(latencyNanos);
+    } else
         executeTPCCFailCount[transactionNumber - 1]++;
 }
+
+void TransactionalStatistic::addLatencies(
+    LatencyHistogram* perTransaction) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < 5; i++) {
+        perTransaction[i] += latencies[i];
+    }
+}
+
+void TransactionalStatistic::addCounts(unsigned long long* succeeded,
+                                       unsigned long long* failed,
+                                       LatencyHistogram* perTransaction) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int i = 0; i < 5; i++) {
+        succeeded[i] += executeTPCCSuccessCount[i];
+        failed[i] += executeTPCCFailCount[i];
+        perTransaction[i] += latencies[i];
+    }
+}
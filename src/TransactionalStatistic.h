@@ -18,16 +18,30 @@ limitations under the License.
 #ifndef TRANSACTIONALSTATISTIC_H
 #define TRANSACTIONALSTATISTIC_H
 
+#include "Histogram.h"
+
+#include <cstdint>
+#include <mutex>
+
 class TransactionalStatistic {
 
   private:
     unsigned long long executeTPCCSuccessCount[5];
     unsigned long long executeTPCCFailCount[5];
+    LatencyHistogram latencies[5];
+    // held by the thread that counts and by those that read the counts
+    mutable std::mutex mutex;
 
   public:
     TransactionalStatistic();
     void addResult(unsigned long long& transcationalResults);
-    void executeTPCCSuccess(int transactionNumber, bool success);
+    // Counts a transaction, and records the latency of a successful one.
+    void executeTPCCSuccess(int transactionNumber, bool success,
+                            uint64_t latencyNanos);
+    void addLatencies(LatencyHistogram* perTransaction) const;
+    // Adds the counts and latencies of every transaction.
+    void addCounts(unsigned long long* succeeded, unsigned long long* failed,
+                   LatencyHistogram* perTransaction) const;
 };
 
 #endif
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include "Transactions.h"
 
+#include "Clock.h"
 #include "DataSource.h"
 #include "DbcTools.h"
 #include "Log.h"
@@ -241,7 +242,7 @@ bool Transactions::executeNewOrder(Dialect* dialect, SQLHDBC& hDBC, mz::Config&
     };
 
     // 2.4.1.1
-    int wId = chRandom::uniformInt(1, warehouseCount);
+    int wId = homeWId ? homeWId : chRandom::uniformInt(1, warehouseCount);
     // 2.4.1.2
     int dId = chRandom::uniformInt(1, 10);
     int cId = chRandom::nonUniformInt(1023, 1, 3000, 867);
@@ -272,7 +273,7 @@ bool Transactions::executeNewOrder(Dialect* dialect, SQLHDBC& hDBC, mz::Config&
     }
     // 2.4.1.6
     SQL_TIMESTAMP_STRUCT oEntryD;
-    DataSource::getCurrentTimestamp(oEntryD, cfg.order_entry_date_offset_millis(chRandom::rng) / 1000);
+    Clock::get(cfg.order_entry_date_offset_millis(chRandom::rng) / 1000, oEntryD);
 
     SQLLEN nIdicator = 0;
     SQLCHAR buf[1024] = {0};
@@ -445,7 +446,7 @@ bool Transactions::executeNewOrder(Dialect* dialect, SQLHDBC& hDBC, mz::Config&
 bool Transactions::executePayment(Dialect* dialect, SQLHDBC& hDBC, mz::Config& cfg) {
 
     // 2.5.1.1
-    int wId = chRandom::uniformInt(1, warehouseCount);
+    int wId = homeWId ? homeWId : chRandom::uniformInt(1, warehouseCount);
     // 2.5.1.2
     int dId = chRandom::uniformInt(1, 10);
 
@@ -474,7 +475,7 @@ bool Transactions::executePayment(Dialect* dialect, SQLHDBC& hDBC, mz::Config& c
 
     // 2.5.1.4
     SQL_TIMESTAMP_STRUCT hDate;
-    DataSource::getCurrentTimestamp(hDate);
+    Clock::get(0, hDate);
 
     SQLLEN nIdicator = 0;
     SQLCHAR buf[1024] = {0};
@@ -663,7 +664,7 @@ bool Transactions::executePayment(Dialect* dialect, SQLHDBC& hDBC, mz::Config& c
 bool Transactions::executeOrderStatus(Dialect* dialect, SQLHDBC& hDBC) {
 
     // 2.6.1.1
-    int wId = chRandom::uniformInt(1, warehouseCount);
+    int wId = homeWId ? homeWId : chRandom::uniformInt(1, warehouseCount);
     // 2.6.1.2
     int dId = chRandom::uniformInt(1, 10);
     int y = chRandom::uniformInt(1, 100);
@@ -762,12 +763,12 @@ bool Transactions::executeOrderStatus(Dialect* dialect, SQLHDBC& hDBC) {
 bool Transactions::executeDelivery(Dialect* dialect, SQLHDBC& hDBC, mz::Config& cfg) {
 
     // 2.7.1.1
-    int wId = chRandom::uniformInt(1, warehouseCount);
+    int wId = homeWId ? homeWId : chRandom::uniformInt(1, warehouseCount);
     // 2.7.1.2
     int oCarrierId = chRandom::uniformInt(1, 10);
     // 2.7.1.3
     SQL_TIMESTAMP_STRUCT olDeliveryD;
-    DataSource::getCurrentTimestamp(olDeliveryD, cfg.orderline_delivery_date_offset_millis(chRandom::rng));
+    Clock::get(cfg.orderline_delivery_date_offset_millis(chRandom::rng) / 1000, olDeliveryD);
 
     SQLLEN nIdicator = 0;
     SQLCHAR buf[1024] = {0};
@@ -879,8 +880,8 @@ bool Transactions::executeDelivery(Dialect* dialect, SQLHDBC& hDBC, mz::Config&
 bool Transactions::executeStockLevel(Dialect* dialect, SQLHDBC& hDBC) {
 
     // 2.8.1.1
-    int wId = chRandom::uniformInt(1, warehouseCount);
-    int dId = chRandom::uniformInt(1, 10);
+    int wId = homeWId ? homeWId : chRandom::uniformInt(1, warehouseCount);
+    int dId = homeDId ? homeDId : chRandom::uniformInt(1, 10);
     // 2.8.1.2
     int threshold = chRandom::uniformInt(10, 20);
 
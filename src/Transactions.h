@@ -69,12 +69,22 @@ class Transactions {
     SQLHSTMT slStockSelect = 0;
 
     int warehouseCount;
+    // home warehouse and district of the terminal, or 0 for random ones
+    int homeWId = 0;
+    int homeDId = 0;
 
     bool prepare(Dialect* dialect, SQLHDBC& hDBC);
 
   public:
     Transactions(int wc) : warehouseCount(wc) {}
     bool prepareStatements(Dialect* dialect, SQLHDBC& hDBC);
+    // Runs the following transactions for a terminal bound to warehouse wId,
+    // and with StockLevel to district dId (TPC-C 2.8.1.1), or with 0 for
+    // random ones each time.
+    void bindTerminal(int wId, int dId) {
+        homeWId = wId;
+        homeDId = dId;
+    }
 
     bool executeNewOrder(Dialect* dialect, SQLHDBC& hDBC, mz::Config& cfg);
     bool executePayment(Dialect* dialect, SQLHDBC& hDBC, mz::Config& cfg);
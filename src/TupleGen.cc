@@ -17,64 +17,139 @@ limitations under the License.
 
 #include "TupleGen.h"
 
+#include "Clock.h"
+#include "Columnar.h"
 #include "Defines.h"
+#include "Gzip.h"
 #include "mz-config.h"
 
-#include <err.h>
-#include <iostream>
+#include <cstdlib>
+#include <unistd.h>
 #include "Random.h"
 
-std::ofstream TupleGen::warehouseStream;
-std::ofstream TupleGen::districtStream;
-std::ofstream TupleGen::customerStream;
-std::ofstream TupleGen::historyStream;
-std::ofstream TupleGen::neworderStream;
-std::ofstream TupleGen::orderStream;
-std::ofstream TupleGen::orderlineStream;
-std::ofstream TupleGen::itemStream;
-std::ofstream TupleGen::stockStream;
-std::ofstream TupleGen::nationStream;
-std::ofstream TupleGen::supplierStream;
-std::ofstream TupleGen::regionStream;
+RowWriter& TupleGen::stream(Table t) {
+    switch (t) {
+    case Table::warehouse:
+        return warehouseStream;
+    case Table::district:
+        return districtStream;
+    case Table::customer:
+        return customerStream;
+    case Table::history:
+        return historyStream;
+    case Table::neworder:
+        return neworderStream;
+    case Table::order:
+        return orderStream;
+    case Table::orderline:
+        return orderlineStream;
+    case Table::item:
+        return itemStream;
+    case Table::stock:
+        return stockStream;
+    case Table::nation:
+        return nationStream;
+    case Table::supplier:
+        return supplierStream;
+    case Table::region:
+        return regionStream;
+    }
+    abort();
+}
+
+void TupleGen::openFile(Table t, const std::string& outDir,
+                        const std::string& suffix, OutputFormat format) {
+    // Only one format of a file may exist, or the importer could pick up a
+    // stale one.
+    removeOutputFiles(outDir, t, suffix);
+    auto text = outDir + "/" + tableFileName(t) + suffix;
+    switch (format) {
+    case OutputFormat::text:
+        open(t, std::unique_ptr<RowSink>(new FileSink(text)));
+        break;
+    case OutputFormat::gzip:
+        open(t, std::unique_ptr<RowSink>(new GzipSink(text + gzipSuffix)));
+        break;
+    case OutputFormat::columnar:
+        open(t, std::unique_ptr<RowSink>(new ColumnarSink(
+                    outDir + "/" + tableName(t) + columnarExtension + suffix,
+                    t)));
+        break;
+    }
+}
+
+void TupleGen::open(Table t, std::unique_ptr<RowSink> sink) {
+    if (manifest)
+        sink.reset(new ChecksumSink(std::move(sink), t, *manifest));
+    stream(t).open(std::move(sink));
+}
+
+void TupleGen::openOutputFiles(const std::string& outDir,
+                               OutputFormat format) {
+    openWarehouseOutputFiles(outDir, "", format);
+    openFixedOutputFiles(outDir, format);
+}
+
+void TupleGen::openWarehouseOutputFiles(const std::string& outDir,
+                                        const std::string& suffix,
+                                        OutputFormat format) {
+    for (int i = 0; i < tableCount; i++) {
+        auto t = static_cast<Table>(i);
+        if (isWarehouseScoped(t))
+            openFile(t, outDir, suffix, format);
+    }
+}
 
-void ofopen(std::ofstream& f, const std::string& path) {
-    f.open(path);
-    if (f.fail()) {
-        err(1, "opening %s", path.c_str());
+void TupleGen::openFixedOutputFiles(const std::string& outDir,
+                                    OutputFormat format) {
+    for (int i = 0; i < tableCount; i++) {
+        auto t = static_cast<Table>(i);
+        if (!isWarehouseScoped(t))
+            openFile(t, outDir, "", format);
     }
 }
 
-void TupleGen::openOutputFiles(const std::string& outDir) {
-    ofopen(warehouseStream, outDir + "/warehouse.tbl");
-    ofopen(districtStream, outDir + "/district.tbl");
-    ofopen(customerStream, outDir + "/customer.tbl");
-    ofopen(historyStream, outDir + "/history.tbl");
-    ofopen(neworderStream, outDir + "/neworder.tbl");
-    ofopen(orderStream, outDir + "/order.tbl");
-    ofopen(orderlineStream, outDir + "/orderline.tbl");
-    ofopen(itemStream, outDir + "/item.tbl");
-    ofopen(stockStream, outDir + "/stock.tbl");
-    ofopen(nationStream, outDir + "/nation.tbl");
-    ofopen(supplierStream, outDir + "/supplier.tbl");
-    ofopen(regionStream, outDir + "/region.tbl");
+void TupleGen::openOutput(Table t, std::unique_ptr<RowSink> sink) {
+    open(t, std::move(sink));
 }
 
 void TupleGen::closeOutputFiles() {
-    warehouseStream.close();
-    districtStream.close();
-    customerStream.close();
-    historyStream.close();
-    neworderStream.close();
-    orderStream.close();
-    orderlineStream.close();
-    itemStream.close();
-    stockStream.close();
-    nationStream.close();
-    supplierStream.close();
-    regionStream.close();
+    for (int i = 0; i < tableCount; i++) {
+        stream(static_cast<Table>(i)).close();
+    }
+}
+
+bool TupleGen::removeOutputFiles(const std::string& outDir, Table t,
+                                 const std::string& suffix) {
+    auto text = outDir + "/" + tableFileName(t) + suffix;
+    bool removed = false;
+    for (const auto& path :
+         {text, text + gzipSuffix,
+          outDir + "/" + tableName(t) + columnarExtension + suffix}) {
+        if (unlink(path.c_str()) == 0)
+            removed = true;
+    }
+    return removed;
+}
+
+void TupleGen::removeStaleShards(const std::string& outDir, int firstShard) {
+    for (int i = 0; i < tableCount; i++) {
+        auto t = static_cast<Table>(i);
+        if (!isWarehouseScoped(t))
+            continue;
+        for (int shard = firstShard;; shard++) {
+            if (!removeOutputFiles(outDir, t, shardSuffix(shard)))
+                break;
+        }
+    }
+}
+
+void TupleGen::seekRow(Table t, int wId, int row) {
+    chRandom::seek(static_cast<uint32_t>(t), wId, row);
 }
 
 void TupleGen::genWarehouse(int& wId) {
+    seekRow(Table::warehouse, wId, 0);
     warehouseStream << wId << csvDelim;                        // W_ID
     DataSource::addAlphanumeric64(6, 10, warehouseStream, true);  // W_NAME
     DataSource::addAlphanumeric64(10, 20, warehouseStream, true); // W_STREET_1
@@ -84,10 +159,11 @@ void TupleGen::genWarehouse(int& wId) {
     DataSource::addWDCZip(warehouseStream, true);                 // W_ZIP
     DataSource::addDouble(0.0, 0.2, 4, warehouseStream, true);    // W_TAX
     warehouseStream << "300000.00";                            // W_YTD
-    warehouseStream << std::endl;
+    warehouseStream.endRow();
 }
 
 void TupleGen::genDistrict(int& dId, int& wId) {
+    seekRow(Table::district, wId, dId);
     districtStream << dId << csvDelim;                        // D_ID
     districtStream << wId << csvDelim;                        // D_W_ID
     DataSource::addAlphanumeric64(6, 10, districtStream, true);  // D_NAME
@@ -99,25 +175,20 @@ void TupleGen::genDistrict(int& dId, int& wId) {
     DataSource::addDouble(0.0, 0.2, 4, districtStream, true);    // D_TAX
     districtStream << "30000.00" << csvDelim;                 // D_YTD
     districtStream << "3001";                                 // D_NEXT_O_ID
-    districtStream << std::endl;
+    districtStream.endRow();
 }
 
 void TupleGen::genCustomer(int& cId, int& dId, int& wId,
-                           std::string& customerTime) {
-    std::string cLast;
-    if (cId <= 1000)
-        DataSource::genCLast(cId - 1, cLast);
-    else
-        DataSource::randomCLast(cLast);
-
-    std::string cState = DataSource::randomState();
+                           const char* customerTime) {
+    seekRow(Table::customer, wId, customerRow(dId, cId));
+    const char* cState = DataSource::randomState();
 
     customerStream << cId << csvDelim;                        // C_ID
     customerStream << dId << csvDelim;                        // C_D_ID
     customerStream << wId << csvDelim;                        // C_W_ID
     DataSource::addAlphanumeric64(8, 16, customerStream, true);  // C_FIRST
     customerStream << "OE" << csvDelim;                       // C_MIDDLE
-    customerStream << cLast << csvDelim;                      // C_LAST
+    DataSource::addCLast(cId, customerStream, true);             // C_LAST
     DataSource::addAlphanumeric64(10, 20, customerStream, true); // C_STREET_1
     DataSource::addAlphanumeric64(10, 20, customerStream, true); // C_STREET_2
     DataSource::addAlphanumeric64(10, 20, customerStream, true); // C_CITY
@@ -136,32 +207,36 @@ void TupleGen::genCustomer(int& cId, int& dId, int& wId,
     customerStream << "1" << csvDelim;                     // C_PAYMENT_CNT
     customerStream << "0" << csvDelim;                     // C_DELIVERY_CNT
     DataSource::addAlphanumeric64(300, 500, customerStream, true); // C_DATA
-    customerStream << (int) (cState.c_str())[0];                // C_N_NATIONKEY
-    customerStream << std::endl;
+    customerStream << (int) cState[0];                        // C_N_NATIONKEY
+    customerStream.endRow();
 }
 
 void TupleGen::genHistory(int& cId, int& dId, int& wId, mz::Config& cfg) {
+    seekRow(Table::history, wId, customerRow(dId, cId));
     historyStream << cId << csvDelim; // H_C_ID
     historyStream << dId << csvDelim; // H_C_D_ID
     historyStream << wId << csvDelim; // H_C_W_ID
     historyStream << dId << csvDelim; // H_D_ID
     historyStream << wId << csvDelim; // H_W_ID
-    historyStream << DataSource::getCurrentTimeString(cfg.hist_date_offset_millis(chRandom::rng) / 1000)
-                  << csvDelim;            // H_DATE - current date and time
+    char hDate[Clock::timestampLength + 1];
+    Clock::format(cfg.hist_date_offset_millis(chRandom::rng) / 1000, hDate);
+    historyStream << hDate << csvDelim;   // H_DATE - current date and time
     historyStream << "10.00" << csvDelim; // H_AMOUNT
     DataSource::addAlphanumeric64(12, 24, historyStream, false); // H_DATA
-    historyStream << std::endl;
+    historyStream.endRow();
 }
 
 void TupleGen::genNeworder(int& oId, int& dId, int& wId) {
     neworderStream << oId << csvDelim; // NO_O_ID
     neworderStream << dId << csvDelim; // NO_D_ID
     neworderStream << wId;             // NO_W_ID
-    neworderStream << std::endl;
+    neworderStream.endRow();
 }
 
 void TupleGen::genOrder(int& oId, int& dId, int& wId, int& cId, int& olCount,
-                        std::string& orderTime) {
+                        const char* orderTime) {
+    // The caller has already drawn O_OL_CNT and O_ENTRY_D from this row's
+    // stream, see genWarehouses.
     orderStream << oId << csvDelim;       // O_ID
     orderStream << dId << csvDelim;       // O_D_ID
     orderStream << wId << csvDelim;       // O_W_ID
@@ -175,20 +250,21 @@ void TupleGen::genOrder(int& oId, int& dId, int& wId, int& cId, int& olCount,
         orderStream << "" << csvDelim;
     orderStream << olCount << csvDelim; // O_OL_CNT
     orderStream << "1";                 // O_ALL_LOCAL
-    orderStream << std::endl;
+    orderStream.endRow();
 }
 
 void TupleGen::genOrderline(int& oId, int& dId, int& wId, int& olNumber,
-                            std::string& orderTime) {
+                            const char* orderTime) {
+    seekRow(Table::orderline, wId, orderRow(dId, oId) * 16 + olNumber);
     orderlineStream << oId << csvDelim;                // OL_O_ID
     orderlineStream << dId << csvDelim;                // OL_D_ID
     orderlineStream << wId << csvDelim;                // OL_W_ID
     orderlineStream << olNumber << csvDelim;           // OL_NUMBER
     DataSource::addInt(1, 100000, orderlineStream, true); // OL_I_ID
     orderlineStream << wId << csvDelim;                // OL_SUPPLY_W_ID
-    orderlineStream << (oId <= 2100 ? orderTime : "")
-                    << csvDelim;        // OL_DELIVERY_D = O_ENTRY_D if
-                                        // OL_O_ID <= 2100, null otherwise
+    if (oId <= 2100)                    // OL_DELIVERY_D = O_ENTRY_D if
+        orderlineStream << orderTime;   // OL_O_ID <= 2100, null otherwise
+    orderlineStream << csvDelim;
     orderlineStream << "5" << csvDelim; // OL_QUANTITY
     if (oId <= 2100) // OL_AMOUNT = 0.00 if OL_O_ID <= 2100, random within
                      // [0.01..9999.99] otherwise
@@ -196,23 +272,25 @@ void TupleGen::genOrderline(int& oId, int& dId, int& wId, int& olNumber,
     else
         DataSource::addDouble(0.01, 9999.99, 2, orderlineStream, true);
     DataSource::addAlphanumeric64(24, orderlineStream, false); // OL_DIST_INFO
-    orderlineStream << std::endl;
+    orderlineStream.endRow();
 }
 
 void TupleGen::genItem(int& iId, mz::Config& cfg) {
+    seekRow(Table::item, 0, iId);
     itemStream << iId << csvDelim;                        // I_ID
     DataSource::addInt(1, 10000, itemStream, true);          // I_IM_ID
     DataSource::addAlphanumeric64(14, 24, itemStream, true); // I_NAME
 
-    DataSource::writeDouble(cfg.item_price_cents(chRandom::rng) / 100.0, itemStream, true);  // I_PRICE
+    DataSource::writeDecimal(cfg.item_price_cents(chRandom::rng), 2, itemStream, true);  // I_PRICE
     if (DataSource::randomTrue(0.1))                      // I_DATA
         DataSource::addAlphanumeric64Original(26, 50, itemStream, false);
     else
         DataSource::addAlphanumeric64(26, 50, itemStream, false);
-    itemStream << std::endl;
+    itemStream.endRow();
 }
 
 void TupleGen::genStock(int& iId, int& wId) {
+    seekRow(Table::stock, wId, iId);
     stockStream << iId << csvDelim;                    // S_I_ID
     stockStream << wId << csvDelim;                    // S_W_ID
     DataSource::addInt(10, 100, stockStream, true);       // S_QUANTITY
@@ -235,21 +313,24 @@ void TupleGen::genStock(int& iId, int& wId) {
         DataSource::addAlphanumeric64(26, 50, stockStream, true);
     stockStream << ((iId * wId) %
                     10000); // S_SU_SUPPKEY - no TPC-C/CH-benCHmark spec
-    stockStream << std::endl;
+    stockStream.endRow();
 }
 
 void TupleGen::genNation(const Nation& n) {
+    seekRow(Table::nation, 0, n.id);
     nationStream << n.id << csvDelim;                    // N_NATIONKEY
     nationStream << n.name << csvDelim;                  // N_NAME
     nationStream << n.rId << csvDelim;                   // N_REGIONKEY
     DataSource::addTextString(31, 114, nationStream, false); // N_COMMENT
-    nationStream << std::endl;
+    nationStream.endRow();
 }
 
 void TupleGen::genSupplier(int& suId) {
+    seekRow(Table::supplier, 0, suId);
     supplierStream << suId << csvDelim; // SU_SUPPKEY
-    supplierStream << "Supplier#" << DataSource::strLeadingZero(suId, 9)
-                   << csvDelim;                               // SU_NAME
+    supplierStream << "Supplier#";                            // SU_NAME
+    supplierStream.putInt(suId, 9);
+    supplierStream << csvDelim;
     DataSource::addAlphanumeric64(10, 40, supplierStream, true); // SU_ADDRESS
     DataSource::addNId(supplierStream, true);                    // SU_NATIONKEY
     DataSource::addSuPhone(suId, supplierStream, true);          // SU_PHONE
@@ -264,12 +345,13 @@ void TupleGen::genSupplier(int& suId) {
                                           false);
     else
         DataSource::addTextString(25, 100, supplierStream, false);
-    supplierStream << std::endl;
+    supplierStream.endRow();
 }
 
 void TupleGen::genRegion(int& rId, const char* rName) {
+    seekRow(Table::region, 0, rId);
     regionStream << rId << csvDelim;                     // R_REGIONKEY
     regionStream << rName << csvDelim;                   // R_NAME
     DataSource::addTextString(31, 115, regionStream, false); // R_COMMENT
-    regionStream << std::endl;
+    regionStream.endRow();
 }
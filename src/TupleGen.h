@@ -19,45 +19,94 @@ limitations under the License.
 #define TUPLEGEN_H
 
 #include "DataSource.h"
+#include "Manifest.h"
+#include "RowWriter.h"
 
-#include <fstream>
 #include <string>
+#include "Tables.h"
 #include "mz-config.h"
 
+// How gen encodes the tables it writes to files.
+enum class OutputFormat {
+    text,     // pipe-delimited <table>.tbl
+    gzip,     // gzip-compressed <table>.tbl.gz
+    columnar, // typed columns in <table>.col, see Columnar.h
+};
+
+// A set of output files for the generated tables. Each gen job owns its own
+// TupleGen, so several of them can generate disjoint warehouse ranges
+// concurrently.
 class TupleGen {
 
   private:
-    static std::ofstream warehouseStream;
-    static std::ofstream districtStream;
-    static std::ofstream customerStream;
-    static std::ofstream historyStream;
-    static std::ofstream neworderStream;
-    static std::ofstream orderStream;
-    static std::ofstream orderlineStream;
-    static std::ofstream itemStream;
-    static std::ofstream stockStream;
-    static std::ofstream nationStream;
-    static std::ofstream supplierStream;
-    static std::ofstream regionStream;
+    RowWriter warehouseStream;
+    RowWriter districtStream;
+    RowWriter customerStream;
+    RowWriter historyStream;
+    RowWriter neworderStream;
+    RowWriter orderStream;
+    RowWriter orderlineStream;
+    RowWriter itemStream;
+    RowWriter stockStream;
+    RowWriter nationStream;
+    RowWriter supplierStream;
+    RowWriter regionStream;
+
+    Manifest* manifest = nullptr;
+
+    RowWriter& stream(Table t);
+    void open(Table t, std::unique_ptr<RowSink> sink);
+    void openFile(Table t, const std::string& outDir,
+                  const std::string& suffix, OutputFormat format);
 
   public:
-    static void openOutputFiles(const std::string& outDir);
-    static void closeOutputFiles();
-    static void genWarehouse(int& wId);
-    static void genDistrict(int& dId, int& wId);
-    static void genCustomer(int& cId, int& dId, int& wId,
-                            std::string& customerTime);
-    static void genHistory(int& cId, int& dId, int& wId, mz::Config& cfg);
-    static void genNeworder(int& oId, int& dId, int& wId);
-    static void genOrder(int& oId, int& dId, int& wId, int& cId, int& olCount,
-                         std::string& orderTime);
-    static void genOrderline(int& oId, int& dId, int& wId, int& olNumber,
-                             std::string& orderTime);
-    static void genItem(int& iId, mz::Config& cfg);
-    static void genStock(int& iId, int& wId);
-    static void genNation(const Nation& n);
-    static void genSupplier(int& suId);
-    static void genRegion(int& rId, const char* rName);
+    // Opens all twelve tables as <outDir>/<table>.tbl, or the file name of
+    // the given format.
+    void openOutputFiles(const std::string& outDir,
+                         OutputFormat format = OutputFormat::text);
+    // Opens only the warehouse-scoped tables, as <outDir>/<table>.tbl<suffix>.
+    void openWarehouseOutputFiles(const std::string& outDir,
+                                  const std::string& suffix,
+                                  OutputFormat format = OutputFormat::text);
+    // Opens only ITEM, NATION, SUPPLIER and REGION.
+    void openFixedOutputFiles(const std::string& outDir,
+                              OutputFormat format = OutputFormat::text);
+    // Sends the rows of table t to sink instead of a file.
+    void openOutput(Table t, std::unique_ptr<RowSink> sink);
+    // Adds the row count and checksum of every table opened from now on to
+    // m once it is closed.
+    void recordInto(Manifest* m) { manifest = m; }
+    void closeOutputFiles();
+    // Removes the table's file with the given suffix in every format.
+    // Returns whether there was any.
+    static bool removeOutputFiles(const std::string& outDir, Table t,
+                                  const std::string& suffix);
+    // Removes shard files of the warehouse-scoped tables left behind by an
+    // earlier run, in any format, starting at shard number firstShard.
+    static void removeStaleShards(const std::string& outDir, int firstShard);
+
+    // Positions the random stream at the given row of the table. Every gen*
+    // function seeks to its own row first, so a row's contents depend only on
+    // the seed and the row's key, not on which job generates it or when.
+    static void seekRow(Table t, int wId, int row);
+    static int customerRow(int dId, int cId) { return dId * 3000 + cId; }
+    static int orderRow(int dId, int oId) { return dId * 3000 + oId; }
+
+    void genWarehouse(int& wId);
+    void genDistrict(int& dId, int& wId);
+    void genCustomer(int& cId, int& dId, int& wId,
+                     const char* customerTime);
+    void genHistory(int& cId, int& dId, int& wId, mz::Config& cfg);
+    void genNeworder(int& oId, int& dId, int& wId);
+    void genOrder(int& oId, int& dId, int& wId, int& cId, int& olCount,
+                  const char* orderTime);
+    void genOrderline(int& oId, int& dId, int& wId, int& olNumber,
+                      const char* orderTime);
+    void genItem(int& iId, mz::Config& cfg);
+    void genStock(int& iId, int& wId);
+    void genNation(const Nation& n);
+    void genSupplier(int& suId);
+    void genRegion(int& rId, const char* rName);
 };
 
 #endif
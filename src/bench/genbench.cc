@@ -0,0 +1,363 @@
+/*
+Copyright 2019 Materialize, Inc
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+// Micro-benchmarks for the data generator.
+//
+// Every TupleGen::gen* function and every DataSource::add* helper is run in
+// isolation against a sink that only counts bytes, so the numbers measure
+// generation alone, without file system, compression or database costs.
+// Each benchmark runs batches of doubling size until one batch takes at
+// least --min-time seconds, and reports that batch.
+
+#include "Clock.h"
+#include "DataSource.h"
+#include "Random.h"
+#include "RowWriter.h"
+#include "TupleGen.h"
+#include "mz-config.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <err.h>
+#include <functional>
+#include <getopt.h>
+#include <new>
+#include <string>
+#include <vector>
+
+// Allocations made through operator new since the program started. The
+// benchmarks are single-threaded, so this does not need to be atomic.
+static uint64_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace {
+
+// Counts the bytes handed to it and throws them away.
+class CountingSink : public RowSink {
+    uint64_t& bytes;
+
+  public:
+    explicit CountingSink(uint64_t& bytes_) : bytes(bytes_) {}
+    void write(const char*, size_t len) override { bytes += len; }
+    void close() override {}
+};
+
+struct Benchmark {
+    std::string name;
+    // Generates rows [0, rows) and sends them to sinks that count into bytes.
+    std::function<void(uint64_t rows, uint64_t& bytes)> run;
+};
+
+struct Result {
+    std::string name;
+    uint64_t rows;
+    double seconds;
+    uint64_t bytes;
+    uint64_t allocations;
+};
+
+Result measure(const Benchmark& b, double minTime) {
+    Result r = {b.name, 0, 0, 0, 0};
+    for (uint64_t rows = 1000;; rows *= 2) {
+        uint64_t bytes = 0;
+        uint64_t allocationsBefore = allocations;
+        auto start = std::chrono::steady_clock::now();
+        b.run(rows, bytes);
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        r = {b.name, rows, elapsed.count(), bytes,
+             allocations - allocationsBefore};
+        if (r.seconds >= minTime)
+            return r;
+    }
+}
+
+// A benchmark of one TupleGen::gen* function, which is called with the row
+// number and writes to the stream of table t.
+Benchmark genBenchmark(const char* name, Table t,
+                       std::function<void(TupleGen&, uint64_t)> gen) {
+    // TupleGen holds a 1 MiB buffer per table, which is allocated once here
+    // rather than on every batch.
+    auto tg = std::make_shared<TupleGen>();
+    return {name, [=](uint64_t rows, uint64_t& bytes) {
+                tg->openOutput(t, std::unique_ptr<RowSink>(
+                                      new CountingSink(bytes)));
+                for (uint64_t i = 0; i < rows; i++)
+                    gen(*tg, i);
+                tg->closeOutputFiles();
+            }};
+}
+
+// A benchmark of one DataSource helper, of which each call forms a row.
+Benchmark addBenchmark(const char* name,
+                       std::function<void(RowWriter&, uint64_t)> add) {
+    auto w = std::make_shared<RowWriter>();
+    return {name, [=](uint64_t rows, uint64_t& bytes) {
+                w->open(std::unique_ptr<RowSink>(new CountingSink(bytes)));
+                chRandom::seek(0, 0, 0);
+                for (uint64_t i = 0; i < rows; i++) {
+                    add(*w, i);
+                    w->endRow();
+                }
+                w->close();
+            }};
+}
+
+std::vector<Benchmark> benchmarks(mz::Config& cfg, const char* timestamp) {
+    // Row numbers are mapped onto the keys of warehouse 1, as gen would
+    // generate them, wrapping around at the size of the table.
+    return {
+        genBenchmark("gen/warehouse", Table::warehouse,
+                     [](TupleGen& tg, uint64_t i) {
+                         int wId = 1 + i % 1000;
+                         tg.genWarehouse(wId);
+                     }),
+        genBenchmark("gen/district", Table::district,
+                     [](TupleGen& tg, uint64_t i) {
+                         int dId = 1 + i % 10, wId = 1;
+                         tg.genDistrict(dId, wId);
+                     }),
+        genBenchmark("gen/customer", Table::customer,
+                     [=](TupleGen& tg, uint64_t i) {
+                         int cId = 1 + i % 3000, dId = 1 + i / 3000 % 10;
+                         int wId = 1;
+                         tg.genCustomer(cId, dId, wId, timestamp);
+                     }),
+        genBenchmark("gen/history", Table::history,
+                     [&cfg](TupleGen& tg, uint64_t i) {
+                         int cId = 1 + i % 3000, dId = 1 + i / 3000 % 10;
+                         int wId = 1;
+                         tg.genHistory(cId, dId, wId, cfg);
+                     }),
+        genBenchmark("gen/neworder", Table::neworder,
+                     [](TupleGen& tg, uint64_t i) {
+                         int oId = 2101 + i % 900, dId = 1 + i / 900 % 10;
+                         int wId = 1;
+                         tg.genNeworder(oId, dId, wId);
+                     }),
+        genBenchmark("gen/order", Table::order,
+                     [=](TupleGen& tg, uint64_t i) {
+                         int oId = 1 + i % 3000, dId = 1 + i / 3000 % 10;
+                         int wId = 1, cId = oId, olCount = 5 + i % 11;
+                         TupleGen::seekRow(Table::order, wId,
+                                           TupleGen::orderRow(dId, oId));
+                         tg.genOrder(oId, dId, wId, cId, olCount, timestamp);
+                     }),
+        genBenchmark("gen/orderline", Table::orderline,
+                     [=](TupleGen& tg, uint64_t i) {
+                         int olNumber = 1 + i % 10;
+                         int oId = 1 + i / 10 % 3000;
+                         int dId = 1 + i / 30000 % 10, wId = 1;
+                         tg.genOrderline(oId, dId, wId, olNumber, timestamp);
+                     }),
+        genBenchmark("gen/item", Table::item,
+                     [&cfg](TupleGen& tg, uint64_t i) {
+                         int iId = 1 + i % 100000;
+                         tg.genItem(iId, cfg);
+                     }),
+        genBenchmark("gen/stock", Table::stock,
+                     [](TupleGen& tg, uint64_t i) {
+                         int iId = 1 + i % 100000, wId = 1;
+                         tg.genStock(iId, wId);
+                     }),
+        genBenchmark("gen/nation", Table::nation,
+                     [](TupleGen& tg, uint64_t i) {
+                         tg.genNation(DataSource::getNation(i % 62));
+                     }),
+        genBenchmark("gen/supplier", Table::supplier,
+                     [](TupleGen& tg, uint64_t i) {
+                         int suId = i % 10000;
+                         tg.genSupplier(suId);
+                     }),
+        genBenchmark("gen/region", Table::region,
+                     [](TupleGen& tg, uint64_t i) {
+                         int rId = i % 5;
+                         tg.genRegion(rId, DataSource::getRegion(rId));
+                     }),
+
+        // The helpers are called with arguments gen actually uses.
+        addBenchmark("add/numeric",
+                     [](RowWriter& w, uint64_t) {
+                         DataSource::addNumeric(16, w, false);
+                     }),
+        addBenchmark("add/alphanumeric62",
+                     [](RowWriter& w, uint64_t) {
+                         DataSource::addAlphanumeric62(2, w, false);
+                     }),
+        addBenchmark("add/alphanumeric64",
+                     [](RowWriter& w, uint64_t) {
+                         DataSource::addAlphanumeric64(24, w, false);
+                     }),
+        addBenchmark("add/alphanumeric64-range",
+                     [](RowWriter& w, uint64_t) {
+                         DataSource::addAlphanumeric64(300, 500, w, false);
+                     }),
+        addBenchmark("add/alphanumeric64-original",
+                     [](RowWriter& w, uint64_t) {
+                         DataSource::addAlphanumeric64Original(26, 50, w,
+                                                               false);
+                     }),
+        addBenchmark("add/text-string",
+                     [](RowWriter& w, uint64_t) {
+                         DataSource::addTextString(25, 100, w, false);
+                     }),
+        addBenchmark("add/text-string-customer",
+                     [](RowWriter& w, uint64_t) {
+                         DataSource::addTextStringCustomer(
+                             25, 100, "Complaints", w, false);
+                     }),
+        addBenchmark("add/int",
+                     [](RowWriter& w, uint64_t) {
+                         DataSource::addInt(1, 100000, w, false);
+                     }),
+        addBenchmark("add/double",
+                     [](RowWriter& w, uint64_t) {
+                         DataSource::addDouble(0.01, 9999.99, 2, w, false);
+                     }),
+        addBenchmark("add/decimal",
+                     [&cfg](RowWriter& w, uint64_t) {
+                         DataSource::writeDecimal(
+                             cfg.item_price_cents(chRandom::rng), 2, w,
+                             false);
+                     }),
+        addBenchmark("add/n-id",
+                     [](RowWriter& w, uint64_t) {
+                         DataSource::addNId(w, false);
+                     }),
+        addBenchmark("add/wdc-zip",
+                     [](RowWriter& w, uint64_t) {
+                         DataSource::addWDCZip(w, false);
+                     }),
+        addBenchmark("add/su-phone",
+                     [](RowWriter& w, uint64_t i) {
+                         int suId = i % 10000;
+                         DataSource::addSuPhone(suId, w, false);
+                     }),
+        addBenchmark("add/c-last",
+                     [](RowWriter& w, uint64_t i) {
+                         DataSource::addCLast(1 + i % 3000, w, false);
+                     }),
+    };
+}
+
+void printTable(const std::vector<Result>& results) {
+    printf("%-30s %12s %14s %10s %12s\n", "benchmark", "rows", "rows/s",
+           "MB/s", "allocs/row");
+    for (auto& r : results) {
+        printf("%-30s %12llu %14.0f %10.1f %12.3f\n", r.name.c_str(),
+               (unsigned long long) r.rows, r.rows / r.seconds,
+               r.bytes / r.seconds / 1e6, double(r.allocations) / r.rows);
+    }
+}
+
+void printJson(const std::vector<Result>& results) {
+    printf("[\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        auto& r = results[i];
+        printf("  {\"name\": \"%s\", \"rows\": %llu, \"seconds\": %.6f, "
+               "\"bytes\": %llu, \"allocations\": %llu, "
+               "\"rows_per_sec\": %.1f, \"bytes_per_sec\": %.1f, "
+               "\"allocs_per_row\": %.6f}%s\n",
+               r.name.c_str(), (unsigned long long) r.rows, r.seconds,
+               (unsigned long long) r.bytes,
+               (unsigned long long) r.allocations, r.rows / r.seconds,
+               r.bytes / r.seconds, double(r.allocations) / r.rows,
+               i + 1 < results.size() ? "," : "");
+    }
+    printf("]\n");
+}
+
+const char usage[] =
+    "usage: chbenchmark_genbench [--json] [--filter SUBSTRING] "
+    "[--min-time SECONDS]\n";
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    static struct option longOpts[] = {
+        {"json", no_argument, nullptr, 'j'},
+        {"filter", required_argument, nullptr, 'f'},
+        {"min-time", required_argument, nullptr, 't'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}};
+
+    bool json = false;
+    const char* filter = "";
+    double minTime = 0.5;
+    int c;
+    while ((c = getopt_long(argc, argv, "jf:t:h", longOpts, nullptr)) != -1) {
+        switch (c) {
+        case 'j':
+            json = true;
+            break;
+        case 'f':
+            filter = optarg;
+            break;
+        case 't': {
+            char* end;
+            minTime = strtod(optarg, &end);
+            if (*end || !(minTime > 0))
+                errx(1, "min-time must be a positive number of seconds");
+            break;
+        }
+        case 'h':
+            fputs(usage, stdout);
+            return 0;
+        default:
+            fputs(usage, stderr);
+            return 1;
+        }
+    }
+    if (optind != argc) {
+        fputs(usage, stderr);
+        return 1;
+    }
+
+    // A fixed seed and time make every run generate the same rows.
+    chRandom::setSeed(0);
+    Clock::simulate(0);
+    DataSource::initialize(1);
+    mz::Config cfg = mz::defaultConfig();
+    char timestamp[Clock::timestampLength + 1];
+    Clock::format(0, timestamp);
+
+    std::vector<Result> results;
+    for (auto& b : benchmarks(cfg, timestamp)) {
+        if (b.name.find(filter) == std::string::npos)
+            continue;
+        results.push_back(measure(b, minTime));
+    }
+
+    if (json)
+        printJson(results);
+    else
+        printTable(results);
+    return 0;
+}
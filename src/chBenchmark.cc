@@ -18,22 +18,33 @@ limitations under the License.
 #include <pqxx/pqxx>
 #include "materialized.h"
 #include "AnalyticalStatistic.h"
+#include "Clock.h"
 #include "DataSource.h"
 #include "DbcTools.h"
 #include "Dialect.h"
+#include "Gzip.h"
+#include "LoadReport.h"
 #include "Log.h"
+#include "Manifest.h"
+#include "OdbcLoader.h"
+#include "PgCopy.h"
 #include "PthreadShim.h"
 #include "Queries.h"
 #include "Random.h"
 #include "Schema.h"
+#include "Terminals.h"
 #include "TransactionalStatistic.h"
 #include "Transactions.h"
 #include "TupleGen.h"
 #include "mz-config.h"
 #include "Histogram.h"
 
+#include <array>
 #include <atomic>
+#include <sys/stat.h>
+#include <sys/wait.h>
 #include <err.h>
+#include <functional>
 #include <getopt.h>
 #include <pthread.h>
 #include <sql.h>
@@ -55,18 +66,97 @@ enum class RunState {
     run,
 };
 
+// How the clients run during a phase of the schedule.
+struct PhaseSettings {
+    std::string name;
+    int seconds;
+    // the threads with ids up to these are active, the others idle
+    int transactionalThreads;
+    int analyticThreads;
+    Pacing transactionalPacing;
+    Pacing analyticalPacing;
+    // weights of the transactions, in the order of their numbers
+    std::array<int, 5> mix;
+};
+
+// The phases of a run, the warmup first, and the one that is running. The
+// threads record the statistics of every measured phase separately.
+struct Schedule {
+    std::vector<PhaseSettings> phases;
+    std::atomic<int> current {0};
+    // overdue transactions and queries of threads that a phase stopped
+    std::atomic<unsigned long long> droppedBacklog {0};
+};
+
 typedef struct {
     pthread_barrier_t* barStart;
     std::atomic<RunState>& runState;
     int threadId;
     SQLHDBC hDBC;
+    // the statistics of each measured phase, phases 1 to n at 0 to n - 1
     void* stat;
     int warehouseCount;
-    useconds_t sleepMin;
-    useconds_t sleepMax;
+    Schedule* schedule;
     mz::Config* cfg;
+    // the logical terminals that a transactional thread serves
+    int firstTerminal;
+    int terminals;
+    // whether the terminals are bound to home warehouses and districts
+    bool homeWarehouses;
 } threadParameters;
 
+// Latency of a transaction or query that was due at due and finished at done.
+static uint64_t nanosSince(Terminal::time_point due,
+                           Terminal::time_point done) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(done - due)
+        .count();
+}
+
+// The default mix, in percent.
+static const std::array<int, 5> defaultMix = {44, 44, 4, 4, 4};
+
+// Draws the next transaction of the mix, by its number for the statistics:
+// 1 NewOrder, 2 Payment, 3 OrderStatus, 4 Delivery, 5 StockLevel.
+static int chooseTransaction(const std::array<int, 5>& mix) {
+    int total = 0;
+    for (int weight : mix)
+        total += weight;
+    auto decision = chRandom::uniformInt(1, total);
+    for (int i = 0; i < 4; i++) {
+        if (decision <= mix[i])
+            return i + 1;
+        decision -= mix[i];
+    }
+    return 5;
+}
+
+// Carries the terminals of a thread over into a phase. Those that are
+// overdue have issued their transactions, which stay due when they were, so
+// that their latency still counts the wait; the others are drawn again, with
+// the pacing and, for transactions, the mix of the phase. A thread that the
+// phase does not use drops its terminals, and counts the overdue ones in
+// dropped.
+static void carryOver(TerminalQueue& queue, bool active, const Pacing& pacing,
+                      const std::array<int, 5>* mix,
+                      std::atomic<unsigned long long>& dropped) {
+    auto now = std::chrono::steady_clock::now();
+    for (Terminal& t : queue.takeAll()) {
+        bool overdue = t.due <= now;
+        if (!active) {
+            dropped += overdue;
+            continue;
+        }
+        if (!overdue) {
+            if (mix)
+                t.transaction = chooseTransaction(*mix);
+            t.due = pacing.first(t, now);
+        }
+        queue.schedule(t);
+    }
+}
+
+// Runs the TPC-H queries in turn, each due as the pacing of the phase says,
+// during the phases in which the thread is active.
 static void* analyticalThread(void* args) {
     auto prm = (threadParameters*) args;
     auto aStat = (AnalyticalStatistic*) prm->stat;
@@ -82,31 +172,49 @@ static void* analyticalThread(void* args) {
 
     pthread_barrier_wait(prm->barStart);
 
-    Log::l1() << Log::tm() << "-analytical " << prm->threadId
-              << ":  start warmup\n";
-    while (prm->runState == RunState::warmup) {
-        q = (query % 22) + 1;
-
-        Log::l1() << Log::tm() << "-analytical " << prm->threadId << ": TPC-H "
-                  << q << "\n";
-        queries.executeTPCH(q);
-        query++;
-        auto sleepTime = chRandom::uniformInt(prm->sleepMin, prm->sleepMax);
-        usleep(sleepTime);
-    }
-
-    Log::l1() << Log::tm() << "-analytical " << prm->threadId
-              << ": start test\n";
-    while (prm->runState == RunState::run) {
+    // the thread is a single stream of queries, which a phase that starts
+    // the thread begins with its pacing, and the others carry over
+    auto& schedule = *prm->schedule;
+    TerminalQueue stream;
+    Terminal t;
+    int phase = -1;
+    auto stop = [prm, &schedule, &phase] {
+        return prm->runState == RunState::off || schedule.current != phase;
+    };
+    while (prm->runState != RunState::off) {
+        if (schedule.current != phase) {
+            phase = schedule.current;
+            const auto& settings = schedule.phases[phase];
+            bool active = prm->threadId <= settings.analyticThreads;
+            bool started = stream.size();
+            carryOver(stream, active, settings.analyticalPacing, nullptr,
+                      schedule.droppedBacklog);
+            if (active && !started) {
+                t = {prm->threadId, std::chrono::steady_clock::now()};
+                t.due = settings.analyticalPacing.first(t, t.due);
+                stream.schedule(t);
+            }
+            Log::l1() << Log::tm() << "-analytical " << prm->threadId
+                      << ": start " << settings.name
+                      << (stream.size() ? "\n" : ", idle\n");
+        }
+        if (!stream.size()) {
+            std::this_thread::sleep_for(TerminalQueue::pollInterval);
+            continue;
+        }
+        if (!stream.next(t, stop))
+            continue;
         q = (query % 22) + 1;
 
         Log::l1() << Log::tm() << "-analytical " << prm->threadId << ": TPC-H "
                   << q << "\n";
         b = queries.executeTPCH(q);
-        aStat->executeTPCHSuccess(q, b);
+        auto done = std::chrono::steady_clock::now();
+        if (phase > 0)
+            aStat[phase - 1].executeTPCHSuccess(q, b, nanosSince(t.due, done));
         query++;
-        auto sleepTime = chRandom::uniformInt(prm->sleepMin, prm->sleepMax);
-        usleep(sleepTime);
+        t.due = schedule.phases[phase].analyticalPacing.next(t, 0, done);
+        stream.schedule(t);
     }
 
     Log::l1() << Log::tm() << "-analytical " << prm->threadId << ": exit\n";
@@ -209,6 +317,36 @@ static void materializeThread(mz::Config config, std::promise<std::vector<Histog
     }
 }
 
+// Runs the transaction that the terminal chose, from its home warehouse if
+// it has one. Returns whether it succeeded.
+static bool runTransaction(Transactions& transactions, threadParameters* prm,
+                           const Terminal& t) {
+    auto& cfg = *prm->cfg;
+    auto dialect = cfg.dialect;
+    transactions.bindTerminal(t.wId, t.dId);
+    switch (t.transaction) {
+    case 1:
+        Log::l1() << Log::tm() << "-terminal " << t.id << ": NewOrder\n";
+        return transactions.executeNewOrder(dialect, prm->hDBC, cfg);
+    case 2:
+        Log::l1() << Log::tm() << "-terminal " << t.id << ": Payment\n";
+        return transactions.executePayment(dialect, prm->hDBC, cfg);
+    case 3:
+        Log::l1() << Log::tm() << "-terminal " << t.id << ": OrderStatus\n";
+        return transactions.executeOrderStatus(dialect, prm->hDBC);
+    case 4:
+        Log::l1() << Log::tm() << "-terminal " << t.id << ": Delivery\n";
+        return transactions.executeDelivery(dialect, prm->hDBC, cfg);
+    default:
+        Log::l1() << Log::tm() << "-terminal " << t.id << ": StockLevel\n";
+        return transactions.executeStockLevel(dialect, prm->hDBC);
+    }
+}
+
+// Serves the terminals [firstTerminal, firstTerminal + terminals) over the
+// thread's connection, during the phases in which the thread is active. Each
+// terminal's transactions are due as the pacing of the phase says, and the
+// thread runs the others while one waits.
 static void* transactionalThread(void* args) {
     threadParameters* prm = (threadParameters*) args;
     TransactionalStatistic* tStat = (TransactionalStatistic*) prm->stat;
@@ -218,84 +356,63 @@ static void* transactionalThread(void* args) {
         exit(1);
     }
 
-    bool b;
-
-    auto& cfg = *prm->cfg;
-
     if (DbcTools::autoCommitOff(prm->hDBC)) {
 
         pthread_barrier_wait(prm->barStart);
 
-        Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                  << ": start warmup\n";
-        while (prm->runState == RunState::warmup) {
-            auto decision = chRandom::uniformInt(1, 100);
-
-            if (decision <= 44) {
-                Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                          << ": NewOrder\n";
-                transactions.executeNewOrder(prm->cfg->dialect, prm->hDBC, cfg);
-            }
-            else if (decision <= 88) {
-                Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                          << ": Payment\n";
-                transactions.executePayment(prm->cfg->dialect, prm->hDBC, cfg);
-            }
-            else if (decision <= 92) {
-                Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                          << ": OrderStatus\n";
-                transactions.executeOrderStatus(prm->cfg->dialect, prm->hDBC);
-            }
-            else if (decision <= 96) {
-                Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                          << ": Delivery\n";
-                transactions.executeDelivery(prm->cfg->dialect, prm->hDBC, cfg);
-            }
-            else {
-                Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                          << ": StockLevel\n";
-                transactions.executeStockLevel(prm->cfg->dialect, prm->hDBC);
-            }
-            auto sleepTime = chRandom::uniformInt(prm->sleepMin, prm->sleepMax);
-            usleep(sleepTime);
-        }
-
-        Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                  << ": start test\n";
-        while (prm->runState == RunState::run) {
-            auto decision = chRandom::uniformInt(1, 100);
-            if (decision <= 44) {
-                Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                          << ": NewOrder\n";
-                b = transactions.executeNewOrder(prm->cfg->dialect, prm->hDBC, cfg);
-                tStat->executeTPCCSuccess(1, b);
-            }
-            else if (decision <= 88) {
-                Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                          << ": Payment\n";
-                b = transactions.executePayment(prm->cfg->dialect, prm->hDBC, cfg);
-                tStat->executeTPCCSuccess(2, b);
-            }
-            else if (decision <= 92) {
-                Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                          << ": OrderStatus\n";
-                b = transactions.executeOrderStatus(prm->cfg->dialect, prm->hDBC);
-                tStat->executeTPCCSuccess(3, b);
-            }
-            else if (decision <= 96) {
+        // a phase that starts the thread begins its terminals with the
+        // pacing and mix of the phase, and the others carry them over
+        auto& schedule = *prm->schedule;
+        TerminalQueue terminals;
+        Terminal t;
+        int phase = -1;
+        auto stop = [prm, &schedule, &phase] {
+            return prm->runState == RunState::off ||
+                   schedule.current != phase;
+        };
+        while (prm->runState != RunState::off) {
+            if (schedule.current != phase) {
+                phase = schedule.current;
+                const auto& settings = schedule.phases[phase];
+                bool active = prm->threadId <= settings.transactionalThreads;
+                bool started = terminals.size();
+                carryOver(terminals, active, settings.transactionalPacing,
+                          &settings.mix, schedule.droppedBacklog);
+                // with home warehouses, terminal n works on district n % 10
+                // of warehouse n / 10, counting from 0, for ten terminals per
+                // warehouse
+                auto now = std::chrono::steady_clock::now();
+                for (int i = 0; active && !started && i < prm->terminals;
+                     i++) {
+                    t = {prm->firstTerminal + i, now};
+                    if (prm->homeWarehouses) {
+                        t.wId = (t.id - 1) / 10 % prm->warehouseCount + 1;
+                        t.dId = (t.id - 1) % 10 + 1;
+                    }
+                    t.transaction = chooseTransaction(settings.mix);
+                    t.due = settings.transactionalPacing.first(t, now);
+                    terminals.schedule(t);
+                }
                 Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                          << ": Delivery\n";
-                b = transactions.executeDelivery(prm->cfg->dialect, prm->hDBC, cfg);
-                tStat->executeTPCCSuccess(4, b);
+                          << ": start " << settings.name << " with "
+                          << terminals.size() << " terminals\n";
             }
-            else {
-                Log::l1() << Log::tm() << "-transactional " << prm->threadId
-                          << ": StockLevel\n";
-                b = transactions.executeStockLevel(prm->cfg->dialect, prm->hDBC);
-                tStat->executeTPCCSuccess(5, b);
+            if (!terminals.size()) {
+                std::this_thread::sleep_for(TerminalQueue::pollInterval);
+                continue;
             }
-            auto sleepTime = chRandom::uniformInt(prm->sleepMin, prm->sleepMax);
-            usleep(sleepTime);
+            if (!terminals.next(t, stop))
+                continue;
+            bool b = runTransaction(transactions, prm, t);
+            auto done = std::chrono::steady_clock::now();
+            if (phase > 0)
+                tStat[phase - 1].executeTPCCSuccess(t.transaction, b,
+                                                    nanosSince(t.due, done));
+            const auto& settings = schedule.phases[phase];
+            int finished = t.transaction;
+            t.transaction = chooseTransaction(settings.mix);
+            t.due = settings.transactionalPacing.next(t, finished, done);
+            terminals.schedule(t);
         }
     }
 
@@ -305,7 +422,15 @@ static void* transactionalThread(void* args) {
 
 static int parseInt(const char* context, const char* v) {
     try {
-        return std::stoi(optarg);
+        return std::stoi(v);
+    } catch (const std::exception&) {
+        errx(1, "unable to parse integer %s for %s\n", v, context);
+    }
+}
+
+static uint64_t parseUint64(const char* context, const char* v) {
+    try {
+        return std::stoull(v);
     } catch (const std::exception&) {
         errx(1, "unable to parse integer %s for %s\n", v, context);
     }
@@ -313,7 +438,7 @@ static int parseInt(const char* context, const char* v) {
 
 static double parseDouble(const char* context, const char* v) {
     try {
-        return std::stod(optarg);
+        return std::stod(v);
     } catch (const std::exception&) {
         errx(1, "unable to parse double %s for %s\n", v, context);
     }
@@ -329,8 +454,28 @@ static std::vector<std::string> parseCommaSeparated(const char* v) {
     return ret;
 }
 
+// Parses seconds for each of the five transactions, separated by commas.
+static TransactionTimes parseTransactionTimes(const char* context,
+                                              const char* v) {
+    auto parts = parseCommaSeparated(v);
+    if (parts.size() != 5)
+        errx(1, "%s must list five times", context);
+    TransactionTimes times;
+    for (int i = 0; i < 5; i++) {
+        times[i] = parseDouble(context, parts[i].c_str());
+        if (times[i] < 0)
+            errx(1, "%s cannot be negative", context);
+    }
+    return times;
+}
+
 static void usage() {
-    fprintf(stderr, "usage: chBenchmark [--warehouses N] [--out-dir PATH] gen\n"
+    fprintf(stderr, "usage: chBenchmark [--warehouses N] [--out-dir PATH] [--jobs N] [--seed N]\n"
+                    "                   [--partitions N]\n"
+                    "                   [--simulated-time EPOCH_SECONDS]\n"
+                    "                   [--compress | --format text|columnar] gen\n"
+                    "   or: chBenchmark [--warehouses N] [--jobs N] [--seed N] --load --dsn DSN gen\n"
+                    "   or: chBenchmark --from-warehouse A --to-warehouse B [options] gen\n"
                     "   or: chBenchmark [options] run\n");
 }
 
@@ -354,6 +499,205 @@ static int detectWarehouses(Dialect* dialect, SQLHSTMT& hStmt, int* countOut) {
     return 0;
 }
 
+// The results of a measured phase, summed over the threads.
+struct PhaseResults {
+    unsigned long long analytical = 0;
+    unsigned long long transactional = 0;
+    // one per transaction, and one for the analytical queries
+    std::vector<LatencyHistogram> latencies = std::vector<LatencyHistogram>(6);
+
+    void addAnalytical(AnalyticalStatistic& stat) {
+        stat.addResult(analytical);
+        stat.addLatencies(latencies[5]);
+    }
+    void addTransactional(TransactionalStatistic& stat) {
+        stat.addResult(transactional);
+        stat.addLatencies(latencies.data());
+    }
+    PhaseResults& operator+=(const PhaseResults& other) {
+        analytical += other.analytical;
+        transactional += other.transactional;
+        for (int i = 0; i < 6; i++)
+            latencies[i] += other.latencies[i];
+        return *this;
+    }
+};
+
+// Names of the latency rows of the results: the five transactions and the
+// analytical queries.
+static const char* const latencyNames[] = {
+    "NewOrder", "Payment", "OrderStatus", "Delivery", "StockLevel",
+    "Analytical"};
+static const double latencyQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+// Prints the latency percentiles in milliseconds, of the transactions and
+// queries that were due during the test.
+static void printLatencies(FILE* f, const LatencyHistogram* latencies) {
+    fprintf(f, "Latency [ms]:           %10s %10s %10s %10s %10s\n", "count",
+            "p50", "p90", "p99", "p99.9");
+    for (int i = 0; i < 6; i++) {
+        fprintf(f, "  %-21s %10" PRIu64, latencyNames[i],
+                latencies[i].count());
+        for (double q : latencyQuantiles)
+            fprintf(f, " %10.2f", latencies[i].percentile(q) / 1e6);
+        fprintf(f, "\n");
+    }
+}
+
+static void printLatenciesJson(FILE* f, const LatencyHistogram* latencies) {
+    fprintf(f, "{");
+    for (int i = 0; i < 6; i++) {
+        fprintf(f, "%s\n    \"%s\": {\"count\": %" PRIu64, i ? "," : "",
+                latencyNames[i], latencies[i].count());
+        for (double q : latencyQuantiles)
+            fprintf(f, ", \"p%g_ms\": %.3f", q * 100,
+                    latencies[i].percentile(q) / 1e6);
+        fprintf(f, "}");
+    }
+    fprintf(f, "\n  }");
+}
+
+// Counts and latencies of the five transactions, then of the 22 queries,
+// summed over the threads.
+struct Snapshot {
+    static constexpr int rows = 27;
+    std::array<unsigned long long, rows> succeeded {};
+    std::array<unsigned long long, rows> failed {};
+    std::vector<LatencyHistogram> latencies =
+        std::vector<LatencyHistogram>(rows);
+
+    // Leaves what was counted since the earlier snapshot.
+    Snapshot& operator-=(const Snapshot& earlier) {
+        for (int i = 0; i < rows; i++) {
+            succeeded[i] -= earlier.succeeded[i];
+            failed[i] -= earlier.failed[i];
+            latencies[i] -= earlier.latencies[i];
+        }
+        return *this;
+    }
+};
+
+// What was counted during an interval of --report-interval seconds, which
+// started start seconds into the test. The last one may be shorter.
+struct Interval {
+    double start;
+    double seconds;
+    Snapshot counts;
+};
+
+static const double intervalQuantiles[] = {0.5, 0.95, 0.99};
+
+static std::string rowName(int row) {
+    return row < 5 ? latencyNames[row] : "Q" + std::to_string(row - 4);
+}
+
+// Prints the throughput of an interval, and the count, aborts and latency
+// percentiles in milliseconds of every transaction and query that ran.
+static void printInterval(FILE* f, const Interval& interval) {
+    const auto& counts = interval.counts;
+    unsigned long long transactions = 0;
+    unsigned long long aborted = 0;
+    unsigned long long queries = 0;
+    for (int i = 0; i < 5; i++) {
+        transactions += counts.succeeded[i] + counts.failed[i];
+        aborted += counts.failed[i];
+    }
+    for (int i = 5; i < Snapshot::rows; i++)
+        queries += counts.succeeded[i];
+    fprintf(f, "Interval %g-%g s: %llu tpmC, %llu QphH, %.2f%% aborted\n",
+            interval.start, interval.start + interval.seconds,
+            (unsigned long long) (counts.succeeded[0] * 60 / interval.seconds),
+            (unsigned long long) (queries * 3600 / interval.seconds),
+            transactions ? 100.0 * aborted / transactions : 0.0);
+    for (int i = 0; i < Snapshot::rows; i++) {
+        if (!counts.succeeded[i] && !counts.failed[i])
+            continue;
+        fprintf(f, "  %-11s %8llu ok %6llu failed  ms", rowName(i).c_str(),
+                counts.succeeded[i], counts.failed[i]);
+        for (double q : intervalQuantiles)
+            fprintf(f, "  p%g %.2f", q * 100,
+                    counts.latencies[i].percentile(q) / 1e6);
+        fprintf(f, "\n");
+    }
+}
+
+static void printIntervalJson(FILE* f, const Interval& interval) {
+    const auto& counts = interval.counts;
+    unsigned long long queries = 0;
+    for (int i = 5; i < Snapshot::rows; i++)
+        queries += counts.succeeded[i];
+    fprintf(f, "{\"start\": %g, \"seconds\": %g, \"tpmc\": %llu, "
+               "\"qphh\": %llu, \"rows\": {",
+            interval.start, interval.seconds,
+            (unsigned long long) (counts.succeeded[0] * 60 / interval.seconds),
+            (unsigned long long) (queries * 3600 / interval.seconds));
+    bool first = true;
+    for (int i = 0; i < Snapshot::rows; i++) {
+        if (!counts.succeeded[i] && !counts.failed[i])
+            continue;
+        fprintf(f, "%s\n    \"%s\": {\"count\": %llu, \"failed\": %llu",
+                first ? "" : ",", rowName(i).c_str(), counts.succeeded[i],
+                counts.failed[i]);
+        for (double q : intervalQuantiles)
+            fprintf(f, ", \"p%g_ms\": %.3f", q * 100,
+                    counts.latencies[i].percentile(q) / 1e6);
+        fprintf(f, "}");
+        first = false;
+    }
+    fprintf(f, "}}");
+}
+
+// Takes a snapshot every seconds of the test, and prints and appends to
+// intervals what was counted since the last one, until the test stops. What
+// was counted after the last full interval is reported as a shorter one, so
+// that the intervals add up to the whole test.
+static void intervalThread(int seconds, const std::atomic<RunState>* pRunState,
+                           std::function<Snapshot()> snapshot,
+                           std::vector<Interval>* intervals) {
+    const auto& runState = *pRunState;
+    auto start = std::chrono::steady_clock::now();
+    Snapshot last = snapshot();
+    for (int i = 1;; i++) {
+        auto end = start + std::chrono::seconds(seconds * i);
+        auto now = std::chrono::steady_clock::now();
+        while (runState == RunState::run && now < end) {
+            std::this_thread::sleep_for(
+                std::min<std::chrono::steady_clock::duration>(
+                    TerminalQueue::pollInterval, end - now));
+            now = std::chrono::steady_clock::now();
+        }
+        bool stopped = runState != RunState::run;
+        double length = seconds;
+        if (stopped)
+            length = std::chrono::duration<double>(
+                now - start - std::chrono::seconds(seconds * (i - 1))).count();
+        if (length > 0) {
+            Interval interval = {(double) seconds * (i - 1), length,
+                                 snapshot()};
+            Snapshot current = interval.counts;
+            interval.counts -= last;
+            last = std::move(current);
+            printInterval(stdout, interval);
+            fflush(stdout);
+            intervals->push_back(std::move(interval));
+        }
+        if (stopped)
+            return;
+    }
+}
+
+// Runs a --snapshot-command or --restore-command through the shell.
+static bool runCommand(const char* command) {
+    Log::l2() << Log::tm() << "-running " << command << "\n";
+    int status = system(command);
+    if (status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        Log::l2() << Log::tm() << "-failed\n";
+        return false;
+    }
+    Log::l2() << Log::tm() << "-succeeded\n";
+    return true;
+}
+
 enum LongOnlyOpts {
     MIN_DELAY,
     MAX_DELAY,
@@ -367,8 +711,44 @@ enum LongOnlyOpts {
     KAFKA_URL,
     SCHEMA_REGISTRY_URL,
     CONFIG_FILE_PATH,
+    LOAD,
+    SKIP_LOAD,
+    COMPRESS,
+    FORMAT,
+    FROM_WAREHOUSE,
+    TO_WAREHOUSE,
+    APPEND,
+    SIMULATED_TIME,
+    LOAD_JOBS,
+    COPY_URL,
+    CHECK_JOBS,
+    DEEP_CHECK,
+    REUSE_DATA,
+    RESET,
+    SNAPSHOT_COMMAND,
+    RESTORE_COMMAND,
+    CHUNK_ROWS,
+    RESUME,
+    REPORT,
+    PARTITIONS,
+    PARTITION,
+    GEN_INLINE,
+    SEED,
+    TERMINALS,
+    TARGET_TPM,
+    TARGET_QPH,
+    ARRIVALS,
+    TPCC_TERMINALS,
+    KEYING_TIMES,
+    THINK_TIMES,
+    REPORT_INTERVAL,
 };
 
+static bool importInline(Dialect* dialect, const LoadTarget& target,
+                         const std::string& genDir, int warehouseCount,
+                         int jobs, const mz::Config& mzCfg,
+                         Manifest& manifest);
+
 static int run(int argc, char* argv[]) {
     int longopt_idx;
     struct option longOpts[] = {
@@ -393,6 +773,30 @@ static int run(int argc, char* argv[]) {
         {"kafka-url", required_argument, &longopt_idx, KAFKA_URL},
         {"schema-registry-url", required_argument, &longopt_idx, SCHEMA_REGISTRY_URL},
         {"config-file-path", required_argument, &longopt_idx, CONFIG_FILE_PATH},
+        {"skip-load", no_argument, &longopt_idx, SKIP_LOAD},
+        {"append", no_argument, &longopt_idx, APPEND},
+        {"load-jobs", required_argument, &longopt_idx, LOAD_JOBS},
+        {"copy-url", required_argument, &longopt_idx, COPY_URL},
+        {"check-jobs", required_argument, &longopt_idx, CHECK_JOBS},
+        {"deep-check", no_argument, &longopt_idx, DEEP_CHECK},
+        {"reuse-data", no_argument, &longopt_idx, REUSE_DATA},
+        {"reset", no_argument, &longopt_idx, RESET},
+        {"snapshot-command", required_argument, &longopt_idx, SNAPSHOT_COMMAND},
+        {"restore-command", required_argument, &longopt_idx, RESTORE_COMMAND},
+        {"chunk-rows", required_argument, &longopt_idx, CHUNK_ROWS},
+        {"resume", no_argument, &longopt_idx, RESUME},
+        {"report", required_argument, &longopt_idx, REPORT},
+        {"partition", no_argument, &longopt_idx, PARTITION},
+        {"gen-inline", required_argument, &longopt_idx, GEN_INLINE},
+        {"seed", required_argument, &longopt_idx, SEED},
+        {"terminals", required_argument, &longopt_idx, TERMINALS},
+        {"target-tpm", required_argument, &longopt_idx, TARGET_TPM},
+        {"target-qph", required_argument, &longopt_idx, TARGET_QPH},
+        {"arrivals", required_argument, &longopt_idx, ARRIVALS},
+        {"tpcc-terminals", no_argument, &longopt_idx, TPCC_TERMINALS},
+        {"keying-times", required_argument, &longopt_idx, KEYING_TIMES},
+        {"think-times", required_argument, &longopt_idx, THINK_TIMES},
+        {"report-interval", required_argument, &longopt_idx, REPORT_INTERVAL},
         {nullptr, 0, nullptr, 0}};
 
     int c;
@@ -415,6 +819,32 @@ static int run(int argc, char* argv[]) {
     double flushSleepTime = 0;
     std::optional<std::string> materializedUrl, kafkaUrl, schemaRegistryUrl;
     std::optional<mz::Config> config;
+    bool skipLoad = false;
+    bool append = false;
+    int loadJobs = 1;
+    const char* copyUrl = nullptr;
+    int checkJobs = 4;
+    bool deepCheck = false;
+    bool reuseData = false;
+    bool reset = false;
+    const char* snapshotCommand = nullptr;
+    const char* restoreCommand = nullptr;
+    int chunkRows = 0;
+    bool resume = false;
+    const char* reportFile = nullptr;
+    bool partition = false;
+    int genInline = 0;
+    bool seeded = false;
+    int terminalCount = 0;
+    double targetTpm = 0;
+    double targetQph = 0;
+    const char* arrivals = nullptr;
+    // keying and mean think times of NewOrder, Payment, OrderStatus,
+    // Delivery and StockLevel (TPC-C 5.2.5.7)
+    bool tpccTerminals = false;
+    TransactionTimes keyingTimes = {18, 3, 2, 2, 2};
+    TransactionTimes thinkTimes = {12, 12, 10, 5, 5};
+    int reportInterval = 0;
 
     while ((c = getopt_long(argc, argv, "d:u:p:a:t:w:r:g:o:l:", longOpts,
                             nullptr)) != -1) {
@@ -458,6 +888,95 @@ static int run(int argc, char* argv[]) {
             config = Config::get_config(lc_config);
             break;
         }
+        case SKIP_LOAD:
+            skipLoad = true;
+            break;
+        case APPEND:
+            append = true;
+            break;
+        case LOAD_JOBS:
+            loadJobs = parseInt("load jobs", optarg);
+            break;
+        case COPY_URL:
+            copyUrl = optarg;
+            break;
+        case CHECK_JOBS:
+            checkJobs = parseInt("check jobs", optarg);
+            break;
+        case DEEP_CHECK:
+            deepCheck = true;
+            break;
+        case REUSE_DATA:
+            reuseData = true;
+            break;
+        case RESET:
+            reset = true;
+            break;
+        case SNAPSHOT_COMMAND:
+            snapshotCommand = optarg;
+            reset = true;
+            break;
+        case RESTORE_COMMAND:
+            restoreCommand = optarg;
+            reset = true;
+            break;
+        case CHUNK_ROWS:
+            chunkRows = parseInt("chunk rows", optarg);
+            if (chunkRows < 1)
+                errx(1, "chunk rows must be at least 1");
+            break;
+        case RESUME:
+            resume = true;
+            break;
+        case REPORT:
+            reportFile = optarg;
+            break;
+        case PARTITION:
+            partition = true;
+            break;
+        case GEN_INLINE:
+            genInline = parseInt("inline warehouse count", optarg);
+            if (genInline < 1)
+                errx(1, "inline warehouse count must be at least 1");
+            break;
+        case SEED:
+            chRandom::setSeed(parseUint64("seed", optarg));
+            seeded = true;
+            break;
+        case TERMINALS:
+            terminalCount = parseInt("terminals", optarg);
+            break;
+        case TARGET_TPM:
+            targetTpm = parseDouble("target transactions per minute", optarg);
+            if (targetTpm <= 0)
+                errx(1, "target transactions per minute must be positive");
+            break;
+        case TARGET_QPH:
+            targetQph = parseDouble("target queries per hour", optarg);
+            if (targetQph <= 0)
+                errx(1, "target queries per hour must be positive");
+            break;
+        case ARRIVALS:
+            if (strcmp(optarg, "poisson") != 0 && strcmp(optarg, "fixed") != 0)
+                errx(1, "unknown arrivals %s", optarg);
+            arrivals = optarg;
+            break;
+        case TPCC_TERMINALS:
+            tpccTerminals = true;
+            break;
+        case KEYING_TIMES:
+            keyingTimes = parseTransactionTimes("keying times", optarg);
+            tpccTerminals = true;
+            break;
+        case THINK_TIMES:
+            thinkTimes = parseTransactionTimes("think times", optarg);
+            tpccTerminals = true;
+            break;
+        case REPORT_INTERVAL:
+            reportInterval = parseInt("report interval", optarg);
+            if (reportInterval < 1)
+                errx(1, "report interval must be at least 1 second");
+            break;
         default:
             return 1;
         }
@@ -521,6 +1040,32 @@ static int run(int argc, char* argv[]) {
         errx(1, "analytic threads cannot be negative");
     if (transactionalThreads < 0)
         errx(1, "transactional threads cannot be negative");
+    // with phases in the config file, the run follows them instead of
+    // --run-seconds, with as many threads as the busiest phase activates
+    bool targetRates = targetTpm || targetQph;
+    int defaultTransactionalThreads = transactionalThreads;
+    int defaultAnalyticThreads = analyticThreads;
+    if (!mzCfg.phases.empty())
+        runSeconds = 0;
+    for (const auto& phase : mzCfg.phases) {
+        if (tpccTerminals && phase.targetTpm)
+            errx(1, "--tpcc-terminals cannot be combined with the target_tpm "
+                    "of phase %s", phase.name.c_str());
+        targetRates = targetRates || phase.targetTpm || phase.targetQph;
+        transactionalThreads = std::max(
+            transactionalThreads, phase.transactionalThreads.value_or(0));
+        analyticThreads =
+            std::max(analyticThreads, phase.analyticThreads.value_or(0));
+        runSeconds += phase.seconds;
+    }
+    if (terminalCount && terminalCount < transactionalThreads)
+        errx(1, "terminals cannot be fewer than transactional threads");
+    if (terminalCount && !transactionalThreads)
+        errx(1, "--terminals requires transactional threads");
+    if (arrivals && !targetRates)
+        errx(1, "--arrivals requires --target-tpm or --target-qph");
+    if (tpccTerminals && targetTpm)
+        errx(1, "--tpcc-terminals and --target-tpm are mutually exclusive");
     if (warmupSeconds < 0)
         errx(1, "warmup seconds cannot be negative");
     if (runSeconds < 0)
@@ -529,10 +1074,68 @@ static int run(int argc, char* argv[]) {
         errx(1, "--mz-views requires --mz-sources");
     if (peekConns < 0)
         errx(1, "peek threads cannot be negative");
+    if (append && skipLoad)
+        errx(1, "--append and --skip-load are mutually exclusive");
+    if (loadJobs < 1)
+        errx(1, "load jobs must be at least 1");
+    if (checkJobs < 1)
+        errx(1, "check jobs must be at least 1");
+    if (copyUrl && mzCfg.dialect->getCopyStatements().empty())
+        errx(1, "--copy-url requires a dialect with COPY support");
+
+    if (reset && ((!snapshotCommand &&
+                   mzCfg.dialect->getSnapshotStatements().empty()) ||
+                  (!restoreCommand &&
+                   mzCfg.dialect->getRestoreStatements().empty())))
+        errx(1, "--reset requires a dialect with snapshot support, or "
+                "--snapshot-command and --restore-command");
+    if (resume && !chunkRows)
+        errx(1, "--resume requires --chunk-rows");
+    if (resume && (skipLoad || reuseData))
+        errx(1, "--resume cannot be combined with --skip-load or --reuse-data");
+    if (reuseData && (append || skipLoad))
+        errx(1, "--reuse-data cannot be combined with --append or --skip-load");
+
+    if (genInline && (append || skipLoad || reuseData || chunkRows || partition))
+        errx(1, "--gen-inline cannot be combined with --append, --skip-load, "
+                "--reuse-data, --chunk-rows or --partition");
+    if (seeded && !genInline)
+        errx(1, "--seed requires --gen-inline");
+
+    // the manifest that gen wrote next to the files, to check the loaded
+    // tables' checksums against and to identify the dataset by, or with
+    // --gen-inline the one of the rows generated during the import
+    Manifest manifest;
+    bool haveManifest =
+        !genInline && manifest.read(genDir + "/" + manifestFileName);
+    if (!genInline && (deepCheck || reuseData) && !haveManifest)
+        errx(1, "--deep-check and --reuse-data require %s/%s from gen",
+             genDir.c_str(), manifestFileName);
+    // with --partition, the warehouse-scoped tables are partitioned like the
+    // shards of the dataset, which its manifest records
+    if (partition && (append || skipLoad))
+        errx(1, "--partition cannot be combined with --append or --skip-load");
+    if (partition && (!haveManifest || manifest.firstWarehouse != 1 ||
+                      manifest.partitions < 2))
+        errx(1, "--partition requires %s/%s from gen --partitions or --jobs",
+             genDir.c_str(), manifestFileName);
+    int partitions = partition ? manifest.partitions : 0;
 
     if (logFile)
         Log::open(logFile);
 
+    // with --reset, a database that is already in place (--skip-load) is
+    // reset to the snapshot taken after it was loaded, and a freshly loaded
+    // one is snapshotted once it passed its check, so that every run starts
+    // from the same data. An external restore command runs before connecting,
+    // as it may well restart the server.
+    if (reset && skipLoad && restoreCommand) {
+        Log::l2() << Log::tm() << "Restore:\n";
+        if (!LoadReport::time("restore",
+                              [&] { return runCommand(restoreCommand); }))
+            return 1;
+    }
+
     // Initialization
     Log::l2() << Log::tm() << "Databasesystem:\n-initializing\n";
 
@@ -548,16 +1151,89 @@ static int run(int argc, char* argv[]) {
     SQLHSTMT hStmt = 0;
     SQLAllocHandle(SQL_HANDLE_STMT, hDBC, &hStmt);
 
-    // create database schema
-    Log::l2() << Log::tm() << "Schema creation:\n";
-    if (!Schema::createSchema(mzCfg.dialect, hStmt)) {
-        return 1;
+    // with --load-jobs N > 1 the files are imported over N connections of
+    // their own, as they are with --copy-url, which streams them over libpq,
+    // and with --chunk-rows, which commits every chunk on its own
+    LoadTarget target = {hEnv, dsn, username, password, copyUrl};
+    auto importCSV = [&](bool warehousesOnly) {
+        if (loadJobs > 1 || copyUrl || chunkRows)
+            return Schema::importCSV(mzCfg.dialect, target, genDir, loadJobs,
+                                     warehousesOnly, chunkRows, partitions);
+        return Schema::importCSV(mzCfg.dialect, hStmt, genDir, warehousesOnly,
+                                 partitions);
+    };
+
+    // with --reuse-data, a database whose fingerprint matches the manifest
+    // still holds the checked dataset, and is neither reloaded nor checked
+    bool reuse = false;
+    if (reuseData) {
+        Log::l2() << Log::tm() << "Data reuse:\n";
+        reuse = Schema::matchesFingerprint(mzCfg.dialect, hStmt,
+                                           manifest.digest());
     }
 
-    // import initial database from csv files
-    Log::l2() << Log::tm() << "CSV import:\n";
-    if (!Schema::importCSV(mzCfg.dialect, hStmt, genDir)) {
-        return 1;
+    // with --skip-load the initial database is already in place, e.g.
+    // because gen --load streamed it in
+    if (reuse) {
+        Log::l2() << Log::tm() << "-skipping schema creation and import\n";
+    } else if (append) {
+        // import the warehouses that gen --from-warehouse produced into the
+        // existing database, which no longer matches its fingerprint
+        Schema::writeFingerprint(mzCfg.dialect, hStmt, "");
+        Log::l2() << Log::tm() << "CSV import (append):\n";
+        if (!LoadReport::time("import", [&] { return importCSV(true); })) {
+            return 1;
+        }
+    } else if (!skipLoad) {
+        // create database schema, unless --resume continues an import into
+        // it that failed
+        Log::l2() << Log::tm() << "Schema creation:\n";
+        if (resume) {
+            Log::l2() << Log::tm() << "-skipped, resuming the import\n";
+        } else if (!LoadReport::time("schema", [&] {
+                       return Schema::createSchema(mzCfg.dialect, hStmt) &&
+                              (!partitions ||
+                               Schema::partition(
+                                   mzCfg.dialect, hStmt,
+                                   partitionBounds(1, manifest.lastWarehouse,
+                                                   partitions)));
+                   })) {
+            return 1;
+        }
+
+        // import initial database from csv files, or from the named pipes
+        // that --gen-inline generates into meanwhile
+        Log::l2() << Log::tm()
+                  << (genInline ? "Inline generation and import:\n"
+                                : "CSV import:\n");
+        if (!LoadReport::time("import", [&] {
+                return genInline ? importInline(mzCfg.dialect, target, genDir,
+                                                genInline, loadJobs, mzCfg,
+                                                manifest)
+                                 : importCSV(false);
+            })) {
+            return 1;
+        }
+        haveManifest = haveManifest || genInline;
+
+        // build keys and indexes on the loaded tables
+        Log::l2() << Log::tm() << "Index creation:\n";
+        bool indexed = LoadReport::time("index", [&] {
+            return loadJobs > 1
+                       ? Schema::createIndexes(mzCfg.dialect, target, loadJobs)
+                       : Schema::createIndexes(mzCfg.dialect, hStmt);
+        });
+        if (!indexed) {
+            return 1;
+        }
+    }
+
+    if (reset && skipLoad && !restoreCommand) {
+        Log::l2() << Log::tm() << "Restore:\n";
+        if (!LoadReport::time("restore", [&] {
+                return Schema::restore(mzCfg.dialect, hDBC, hStmt);
+            }))
+            return 1;
     }
 
     // detect warehouse count of loaded initial database
@@ -566,23 +1242,117 @@ static int run(int argc, char* argv[]) {
         return 1;
 
     // perform a check to ensure that initial database was imported
-    // correctly
-    if (!Schema::check(mzCfg.dialect, hStmt)) {
+    // correctly, with --check-jobs N > 1 over N connections of its own
+    const Manifest* expected = deepCheck ? &manifest : nullptr;
+    bool checked = reuse || LoadReport::time("check", [&] {
+        return checkJobs > 1
+                   ? Schema::check(mzCfg.dialect, target, checkJobs, expected)
+                   : Schema::check(mzCfg.dialect, hStmt, expected);
+    });
+    if (!checked) {
+        return 1;
+    }
+
+    // a dataset loaded from genDir is the one its manifest describes, if
+    // that covers all of the warehouses
+    if (!reuse && !skipLoad && haveManifest &&
+        manifest.firstWarehouse == 1 &&
+        manifest.lastWarehouse == warehouseCount &&
+        !Schema::writeFingerprint(mzCfg.dialect, hStmt, manifest.digest())) {
         return 1;
     }
 
+    if (reset && !skipLoad && !reuse) {
+        Log::l2() << Log::tm() << "Snapshot:\n";
+        if (!LoadReport::time("snapshot", [&] {
+                return snapshotCommand
+                           ? runCommand(snapshotCommand)
+                           : Schema::snapshot(mzCfg.dialect, hStmt);
+            }))
+            return 1;
+    }
+
     // fire additional preparation statements
     Log::l2() << Log::tm() << "Additional Preparation:\n";
-    if (!Schema::additionalPreparation(mzCfg.dialect, hStmt)) {
+    if (!LoadReport::time("preparation", [&] {
+            return Schema::additionalPreparation(mzCfg.dialect, hStmt);
+        })) {
         return 1;
     }
 
+    // the transactions modify the dataset, so it can no longer be reused
+    if (transactionalThreads > 0)
+        Schema::writeFingerprint(mzCfg.dialect, hStmt, "");
+
     SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
     SQLDisconnect(hDBC);
     SQLFreeHandle(SQL_HANDLE_DBC, hDBC);
 
     DataSource::initialize(warehouseCount);
 
+    // every transactional thread serves one terminal unless --terminals
+    // spreads more of them over the threads, or the TPC-C terminal model
+    // asks for ten per warehouse
+    if (!terminalCount)
+        terminalCount = tpccTerminals
+                            ? std::max(10 * warehouseCount, transactionalThreads)
+                            : transactionalThreads;
+
+    // the terminals of every transactional thread
+    std::vector<int> threadTerminals(transactionalThreads);
+    for (int i = 0; i < transactionalThreads; i++)
+        threadTerminals[i] = terminalCount / transactionalThreads +
+                             (i < terminalCount % transactionalThreads);
+
+    // the transactions and queries run in a closed loop, each sleeping
+    // between the delays after the last one, or in an open loop with
+    // --target-tpm and --target-qph, arriving at the target rate however
+    // fast the database keeps up, spread over the active terminals and
+    // analytical threads, or with --tpcc-terminals after keying and think
+    // times; a phase overrides the thread counts, rates and mix it sets
+    bool poisson = !arrivals || strcmp(arrivals, "poisson") == 0;
+    auto closedLoop = Pacing::closedLoop(minDelay * 1'000'000,
+                                         maxDelay * 1'000'000);
+    auto phaseSettings = [&](const mz::Phase* phase, const char* name,
+                             int seconds) {
+        PhaseSettings settings = {phase ? phase->name : name, seconds,
+                                  defaultTransactionalThreads,
+                                  defaultAnalyticThreads, closedLoop,
+                                  closedLoop, defaultMix};
+        double tpm = targetTpm;
+        double qph = targetQph;
+        if (phase) {
+            settings.transactionalThreads = phase->transactionalThreads.value_or(
+                settings.transactionalThreads);
+            settings.analyticThreads =
+                phase->analyticThreads.value_or(settings.analyticThreads);
+            tpm = phase->targetTpm.value_or(tpm);
+            qph = phase->targetQph.value_or(qph);
+            settings.mix = phase->mix.value_or(settings.mix);
+        }
+        int activeTerminals = 0;
+        for (int i = 0; i < settings.transactionalThreads; i++)
+            activeTerminals += threadTerminals[i];
+        if (tpccTerminals)
+            settings.transactionalPacing =
+                Pacing::terminals(keyingTimes, thinkTimes);
+        else if (tpm && activeTerminals)
+            settings.transactionalPacing =
+                Pacing::openLoop(tpm / 60 / activeTerminals, poisson);
+        if (qph && settings.analyticThreads)
+            settings.analyticalPacing = Pacing::openLoop(
+                qph / 3600 / settings.analyticThreads, poisson);
+        return settings;
+    };
+    Schedule schedule;
+    schedule.phases.push_back(
+        phaseSettings(nullptr, "warmup", warmupSeconds));
+    if (mzCfg.phases.empty())
+        schedule.phases.push_back(phaseSettings(nullptr, "test", runSeconds));
+    for (const auto& phase : mzCfg.phases)
+        schedule.phases.push_back(phaseSettings(&phase, nullptr, phase.seconds));
+    size_t measuredPhases = schedule.phases.size() - 1;
+
     std::atomic<RunState> runState {RunState::off};
     unsigned int count = analyticThreads + transactionalThreads + 1;
     pthread_barrier_t barStart;
@@ -595,25 +1365,29 @@ static int run(int argc, char* argv[]) {
     std::vector<threadParameters> aprm;
     aprm.reserve(analyticThreads);
     for (int i = 0; i < analyticThreads; i++) {
-        aStat[i] = new AnalyticalStatistic();
+        aStat[i] = new AnalyticalStatistic[measuredPhases];
         aprm.push_back(
-            {&barStart, runState, i + 1, 0, (void*) aStat[i], warehouseCount, (unsigned)(minDelay * 1'000'000), (unsigned)(maxDelay * 1'000'000), &mzCfg});
+            {&barStart, runState, i + 1, 0, (void*) aStat[i], warehouseCount, &schedule, &mzCfg,
+             0, 0, false});
         if (!DbcTools::connect(hEnv, aprm[i].hDBC, dsn, username, password)) {
             exit(1);
         }
         pthread_create(&apt[i], nullptr, analyticalThread, &aprm[i]);
     }
 
-    // start transactional threads and create a statistic object for each
-    // thread
+    // start transactional threads, each serving its share of the terminals,
+    // and create a statistic object for each thread
     TransactionalStatistic* tStat[transactionalThreads];
     pthread_t tpt[transactionalThreads];
     std::vector<threadParameters> tprm;
     tprm.reserve(transactionalThreads);
+    int firstTerminal = 1;
     for (int i = 0; i < transactionalThreads; i++) {
-        tStat[i] = new TransactionalStatistic();
+        tStat[i] = new TransactionalStatistic[measuredPhases];
         tprm.push_back(
-            {&barStart, runState, i + 1, 0, (void*) tStat[i], warehouseCount, (unsigned)(minDelay * 1'000'000), (unsigned)(maxDelay * 1'000'000), &mzCfg});
+            {&barStart, runState, i + 1, 0, (void*) tStat[i], warehouseCount, &schedule, &mzCfg,
+             firstTerminal, threadTerminals[i], tpccTerminals});
+        firstTerminal += threadTerminals[i];
         if (!DbcTools::connect(hEnv, tprm[i].hDBC, dsn, username, password)) {
             exit(1);
         }
@@ -653,21 +1427,56 @@ static int run(int argc, char* argv[]) {
     sleep(warmupSeconds);
 
     runState = RunState::run;
-    Log::l2() << Log::tm() << "-start test\n";
-    sleep(runSeconds);
+    // with --report-interval, the statistics of all threads and phases are
+    // snapshotted every interval, so that stalls show in the time series
+    std::vector<Interval> intervals;
+    std::thread reporter;
+    if (reportInterval) {
+        AnalyticalStatistic** analyticalStats = aStat;
+        TransactionalStatistic** transactionalStats = tStat;
+        auto snapshot = [=] {
+            Snapshot s;
+            for (size_t p = 0; p < measuredPhases; p++) {
+                for (int i = 0; i < analyticThreads; i++)
+                    analyticalStats[i][p].addCounts(s.succeeded.data() + 5,
+                                                    s.failed.data() + 5,
+                                                    s.latencies.data() + 5);
+                for (int i = 0; i < transactionalThreads; i++)
+                    transactionalStats[i][p].addCounts(s.succeeded.data(),
+                                                       s.failed.data(),
+                                                       s.latencies.data());
+            }
+            return s;
+        };
+        reporter = std::thread(intervalThread, reportInterval, &runState,
+                               snapshot, &intervals);
+    }
+    for (size_t p = 1; p < schedule.phases.size(); p++) {
+        Log::l2() << Log::tm() << "-start " << schedule.phases[p].name
+                  << "\n";
+        schedule.current = p;
+        sleep(schedule.phases[p].seconds);
+    }
 
     Log::l2() << Log::tm() << "-stop\n";
     runState = RunState::off;
+    if (reporter.joinable())
+        reporter.join();
 
     // write results to file
-    unsigned long long analyticalResults = 0;
-    unsigned long long transcationalResults = 0;
-    for (int i = 0; i < analyticThreads; i++) {
-        aStat[i]->addResult(analyticalResults);
-    }
-    for (int i = 0; i < transactionalThreads; i++) {
-        tStat[i]->addResult(transcationalResults);
+    std::vector<PhaseResults> phaseResults(measuredPhases);
+    for (size_t p = 0; p < measuredPhases; p++) {
+        for (int i = 0; i < analyticThreads; i++)
+            phaseResults[p].addAnalytical(aStat[i][p]);
+        for (int i = 0; i < transactionalThreads; i++)
+            phaseResults[p].addTransactional(tStat[i][p]);
     }
+    PhaseResults total;
+    for (const auto& results : phaseResults)
+        total += results;
+    unsigned long long analyticalResults = total.analytical;
+    unsigned long long transcationalResults = total.transactional;
+    const auto& latencies = total.latencies;
 
     unsigned long long qphh = analyticalResults * 3600 / runSeconds;
     unsigned long long tpmc = transcationalResults * 60 / runSeconds;
@@ -676,12 +1485,100 @@ static int run(int argc, char* argv[]) {
     printf("Warehouses:             %d\n", warehouseCount);
     printf("Analytical threads:     %d\n", analyticThreads);
     printf("Transactional threads:  %d\n", transactionalThreads);
+    printf("Terminals:              %d\n", terminalCount);
+    if (tpccTerminals) {
+        printf("Keying times:           %g, %g, %g, %g, %g s\n",
+               keyingTimes[0], keyingTimes[1], keyingTimes[2],
+               keyingTimes[3], keyingTimes[4]);
+        printf("Mean think times:       %g, %g, %g, %g, %g s\n",
+               thinkTimes[0], thinkTimes[1], thinkTimes[2], thinkTimes[3],
+               thinkTimes[4]);
+    }
     printf("Warmup seconds:         %d\n", warmupSeconds);
     printf("Run seconds:            %d\n", runSeconds);
     printf("Sleep after query:      %f-%f s\n", minDelay, maxDelay);
+    if (targetTpm || targetQph)
+        printf("Target rates:           %.0f tpm, %.0f qph (%s arrivals)\n",
+               targetTpm, targetQph, poisson ? "poisson" : "fixed");
+    LoadReport::print(stdout);
     printf("\n");
     printf("OLAP throughput [QphH]: %llu\n", qphh);
     printf("OLTP throughput [tpmC]: %llu\n", tpmc);
+    printLatencies(stdout, latencies.data());
+    // overdue arrivals of threads that a phase stopped never ran, and their
+    // latency is not in the percentiles
+    unsigned long long droppedBacklog = schedule.droppedBacklog;
+    if (droppedBacklog)
+        printf("Dropped backlog:        %llu overdue at phase changes\n",
+               droppedBacklog);
+    for (size_t p = 0; !mzCfg.phases.empty() && p < measuredPhases; p++) {
+        const auto& settings = schedule.phases[p + 1];
+        const auto& results = phaseResults[p];
+        printf("\nPhase %s (%d s, %d analytical, %d transactional threads):\n",
+               settings.name.c_str(), settings.seconds,
+               settings.analyticThreads, settings.transactionalThreads);
+        printf("OLAP throughput [QphH]: %llu\n",
+               results.analytical * 3600 / settings.seconds);
+        printf("OLTP throughput [tpmC]: %llu\n",
+               results.transactional * 60 / settings.seconds);
+        printLatencies(stdout, results.latencies.data());
+    }
+
+    if (reportFile) {
+        FILE* f = fopen(reportFile, "w");
+        if (!f)
+            err(1, "opening %s failed", reportFile);
+        fprintf(f, "{\n  \"warehouses\": %d,\n", warehouseCount);
+        fprintf(f, "  \"analytical_threads\": %d,\n", analyticThreads);
+        fprintf(f, "  \"transactional_threads\": %d,\n",
+                transactionalThreads);
+        fprintf(f, "  \"terminals\": %d,\n", terminalCount);
+        fprintf(f, "  \"tpcc_terminals\": %s,\n",
+                tpccTerminals ? "true" : "false");
+        fprintf(f, "  \"warmup_seconds\": %d,\n", warmupSeconds);
+        fprintf(f, "  \"run_seconds\": %d,\n", runSeconds);
+        fprintf(f, "  \"qphh\": %llu,\n", qphh);
+        fprintf(f, "  \"tpmc\": %llu,\n", tpmc);
+        fprintf(f, "  \"dropped_backlog\": %llu,\n", droppedBacklog);
+        if (targetTpm)
+            fprintf(f, "  \"target_tpm\": %g,\n", targetTpm);
+        if (targetQph)
+            fprintf(f, "  \"target_qph\": %g,\n", targetQph);
+        fprintf(f, "  \"latencies\": ");
+        printLatenciesJson(f, latencies.data());
+        fprintf(f, ",\n");
+        if (!mzCfg.phases.empty()) {
+            fprintf(f, "  \"phases\": [");
+            for (size_t p = 0; p < measuredPhases; p++) {
+                const auto& settings = schedule.phases[p + 1];
+                const auto& results = phaseResults[p];
+                fprintf(f,
+                        "%s\n  {\"name\": \"%s\", \"seconds\": %d, "
+                        "\"analytical_threads\": %d, "
+                        "\"transactional_threads\": %d, \"qphh\": %llu, "
+                        "\"tpmc\": %llu,\n  \"latencies\": ",
+                        p ? "," : "", settings.name.c_str(), settings.seconds,
+                        settings.analyticThreads, settings.transactionalThreads,
+                        results.analytical * 3600 / settings.seconds,
+                        results.transactional * 60 / settings.seconds);
+                printLatenciesJson(f, results.latencies.data());
+                fprintf(f, "}");
+            }
+            fprintf(f, "\n  ],\n");
+        }
+        if (reportInterval) {
+            fprintf(f, "  \"intervals\": [");
+            for (size_t i = 0; i < intervals.size(); i++) {
+                fprintf(f, "%s\n  ", i ? "," : "");
+                printIntervalJson(f, intervals[i]);
+            }
+            fprintf(f, "\n  ],\n");
+        }
+        fprintf(f, "  \"setup\": ");
+        LoadReport::printJson(f);
+        fprintf(f, "\n}\n");
+        fclose(f);
+    }
 
     if (peekConns) {
         auto hists = futHist.get();
@@ -719,84 +1616,34 @@ static int run(int argc, char* argv[]) {
     return 0;
 }
 
-static int gen(int argc, char* argv[]) {
-    int longopt_idx;
-    static struct option longOpts[] = {
-        {"warehouses", required_argument, nullptr, 'w'},
-        {"out-dir", required_argument, nullptr, 'o'},
-        {"config-file-path", required_argument, &longopt_idx, CONFIG_FILE_PATH},
-        {nullptr, 0, nullptr, 0}};
-
-    int c;
-    int warehouseCount = 1;
-    const char* outDir = "gen";
-    std::optional<mz::Config> config;
-    while ((c = getopt_long(argc, argv, "w:o:", longOpts, nullptr)) != -1) {
-        if (c == 0) switch (longopt_idx) {
-        case CONFIG_FILE_PATH: {
-            libconfig::Config lc_config;
-            lc_config.readFile(optarg);
-            config = Config::get_config(lc_config);
-            break;
-        }
-        default:
-            return 1;
-        } else switch (c) {
-        case 'w':
-            warehouseCount = parseInt("warehouse count", optarg);
-            break;
-            case 'o':
-                outDir = optarg;
-                break;
-                default:
-                    return 1;
-        }
-    }
-    if (!config) {
-        config = mz::defaultConfig();
-    }
-    mz::Config mzCfg = std::move(*config);
-    argc -= optind;
-    argv += optind;
-
-    if (warehouseCount < 1) {
-        errx(1, "warehouse count must be greater than zero");
-    }
-
-    DataSource::initialize(warehouseCount);
-    TupleGen::openOutputFiles(outDir);
-
-    for (int iId = 1; iId <= 100000; iId++) {
-        // Item
-        TupleGen::genItem(iId, mzCfg);
-    }
-
-    std::string customerTime = "";
-    std::string orderTime;
-    for (int wId = 1; wId <= warehouseCount; wId++) {
+// Generates the warehouse-scoped tables for warehouses [fromWId, toWId].
+static void genWarehouses(TupleGen& tg, int fromWId, int toWId,
+                          const char* customerTime, mz::Config& mzCfg,
+                          const std::atomic<bool>* stop = nullptr) {
+    char orderTime[Clock::timestampLength + 1];
+    for (int wId = fromWId; wId <= toWId && !(stop && *stop); wId++) {
         // Warehouse
-        TupleGen::genWarehouse(wId);
+        tg.genWarehouse(wId);
 
         for (int iId = 1; iId <= 100000; iId++) {
             // Stock
-            TupleGen::genStock(iId, wId);
+            tg.genStock(iId, wId);
         }
 
         for (int dId = 1; dId <= 10; dId++) {
             // District
-            TupleGen::genDistrict(dId, wId);
+            tg.genDistrict(dId, wId);
             int nextOlCount = -1;
             for (int cId = 1; cId <= 3000; cId++) {
                 // Customer
-                if (customerTime.empty())
-                    customerTime = DataSource::getCurrentTimeString();
-                TupleGen::genCustomer(cId, dId, wId, customerTime);
+                tg.genCustomer(cId, dId, wId, customerTime);
 
                 // History
-                TupleGen::genHistory(cId, dId, wId, mzCfg);
+                tg.genHistory(cId, dId, wId, mzCfg);
 
                 // Order
                 int oId = DataSource::permute(cId, 1, 3000);
+                TupleGen::seekRow(Table::order, wId, TupleGen::orderRow(dId, oId));
                 int olCount;
                 if (nextOlCount == -1) {
                     olCount = chRandom::uniformInt(5, 15);
@@ -805,42 +1652,463 @@ static int gen(int argc, char* argv[]) {
                     olCount = nextOlCount;
                     nextOlCount = -1;
                 }
-                orderTime = DataSource::getCurrentTimeString(mzCfg.order_entry_date_offset_millis(chRandom::rng) / 1000);
-                TupleGen::genOrder(oId, dId, wId, cId, olCount, orderTime);
+                Clock::format(mzCfg.order_entry_date_offset_millis(chRandom::rng) / 1000, orderTime);
+                tg.genOrder(oId, dId, wId, cId, olCount, orderTime);
 
                 for (int olNumber = 1; olNumber <= olCount; olNumber++) {
                     // Orderline
-                    TupleGen::genOrderline(oId, dId, wId, olNumber, orderTime);
+                    tg.genOrderline(oId, dId, wId, olNumber, orderTime);
                 }
 
                 // Neworder
                 if (oId > 2100) {
-                    TupleGen::genNeworder(oId, dId, wId);
+                    tg.genNeworder(oId, dId, wId);
                 }
             }
         }
     }
+}
+
+// Sends the warehouse-scoped or the fixed-size tables of tg to loaders that
+// insert the rows into the database as they are generated.
+static void openLoaders(TupleGen& tg, bool warehouseScoped,
+                        const LoadTarget& target, Dialect* dialect) {
+    for (int i = 0; i < tableCount; i++) {
+        auto t = static_cast<Table>(i);
+        if (isWarehouseScoped(t) != warehouseScoped)
+            continue;
+        if (target.copyUrl)
+            tg.openOutput(t, std::unique_ptr<RowSink>(new PgCopyLoader(
+                                 target.copyUrl, tableName(t),
+                                 dialect->getCopyStatements()[i])));
+        else
+            tg.openOutput(t, std::unique_ptr<RowSink>(new OdbcLoader(
+                                 target, tableName(t),
+                                 dialect->getInsertStatements()[i])));
+    }
+}
+
+// Generates ITEM, REGION, NATION and SUPPLIER, which do not depend on the
+// number of warehouses.
+static void genFixed(TupleGen& tg, mz::Config& mzCfg) {
+    for (int iId = 1; iId <= 100000; iId++) {
+        // Item
+        tg.genItem(iId, mzCfg);
+    }
 
     // Region
     for (int rId = 0; rId < 5; rId++) {
-        TupleGen::genRegion(rId, DataSource::getRegion(rId));
+        tg.genRegion(rId, DataSource::getRegion(rId));
     }
 
     // Nation
     for (int i = 0; i < 62; i++) {
-        TupleGen::genNation(DataSource::getNation(i));
+        tg.genNation(DataSource::getNation(i));
     }
 
     // Supplier
     for (int suId = 0; suId < 10000; suId++) {
-        TupleGen::genSupplier(suId);
+        tg.genSupplier(suId);
     }
+}
 
-    TupleGen::closeOutputFiles();
+// Generates warehouses 1..warehouseCount for run --gen-inline into named
+// pipes in a directory of their own under genDir, while the import reads the
+// rows from them, so that no table file is written and generation overlaps
+// the import. The warehouse-scoped tables are generated as jobs shards, each
+// on its own thread writing to all of its pipes at once, so every pipe is
+// imported over a connection of its own.
+static bool importInline(Dialect* dialect, const LoadTarget& target,
+                         const std::string& genDir, int warehouseCount,
+                         int jobs, const mz::Config& mzCfg,
+                         Manifest& manifest) {
+    // mkdtemp leaves the directory to its owner, but the database server
+    // opens the pipes in it, usually as a user of its own.
+    std::string dir = genDir + "/inline.XXXXXX";
+    if (!mkdtemp(&dir[0]) || chmod(dir.c_str(), 0711) != 0) {
+        Log::l2() << Log::tm() << "-creating a directory in " << genDir
+                  << " failed\n";
+        return false;
+    }
 
-    // TODO(benesch): check for write errors.
+    jobs = std::min(jobs, warehouseCount);
+    manifest.seed = chRandom::seedKey;
+    manifest.firstWarehouse = 1;
+    manifest.lastWarehouse = warehouseCount;
+    DataSource::initialize(warehouseCount);
+    char customerTime[Clock::timestampLength + 1];
+    Clock::format(0, customerTime);
+
+    // The pipes are created up front, for the import to find them. The last
+    // generator is the one of the fixed-size tables.
+    std::atomic<bool> stop(false);
+    std::vector<std::unique_ptr<TupleGen>> gens;
+    int pipes = 0;
+    for (int shard = 0; shard <= jobs; shard++) {
+        gens.emplace_back(new TupleGen);
+        gens.back()->recordInto(&manifest);
+        for (int i = 0; i < tableCount; i++) {
+            auto t = static_cast<Table>(i);
+            if (isWarehouseScoped(t) != (shard < jobs))
+                continue;
+            auto path = dir + "/" + tableFileName(t) +
+                        (shard < jobs && jobs > 1 ? shardSuffix(shard) : "");
+            gens.back()->openOutput(
+                t, std::unique_ptr<RowSink>(new PipeSink(path, stop)));
+            pipes++;
+        }
+    }
 
-    return 0;
+    std::vector<int> bounds = partitionBounds(1, warehouseCount, jobs);
+    std::vector<std::thread> workers;
+    for (int shard = 0; shard <= jobs; shard++) {
+        workers.emplace_back([&, shard, cfg = mzCfg]() mutable {
+            TupleGen& tg = *gens[shard];
+            if (shard < jobs)
+                genWarehouses(tg, shard ? bounds[shard - 1] + 1 : 1,
+                              bounds[shard], customerTime, cfg, &stop);
+            else
+                genFixed(tg, cfg);
+            tg.closeOutputFiles();
+        });
+    }
+
+    // An import that fails stops the generators, which would otherwise wait
+    // for it to open its pipe, and a failing generator stops the imports.
+    // Once the import is done, a pipe that is still open will not be read.
+    bool ok = Schema::importCSV(dialect, target, dir, pipes, false, 0, 0,
+                                &stop);
+    bool genFailed = stop.exchange(true);
+    for (auto& w : workers)
+        w.join();
+    gens.clear();
+    rmdir(dir.c_str());
+    if (ok && genFailed)
+        Log::l2() << Log::tm() << "-generating into the pipes failed\n";
+    return ok && !genFailed;
+}
+
+// Finishes gen --load. A freshly created schema still lacks its keys and
+// indexes, which are built over jobs connections now that the rows are in.
+// Its tables are then checked against the manifest of what was generated;
+// appended warehouses only by their row counts.
+static int finishLoad(Dialect* dialect, SQLHDBC& hDBC, SQLHSTMT& hStmt,
+                      bool createIndexes, const LoadTarget& target, int jobs,
+                      const Manifest& manifest) {
+    bool ok = true;
+    if (createIndexes) {
+        Log::l2() << Log::tm() << "Index creation:\n";
+        ok = jobs > 1 ? Schema::createIndexes(dialect, target, jobs)
+                      : Schema::createIndexes(dialect, hStmt);
+    }
+    const Manifest* expected = createIndexes ? &manifest : nullptr;
+    ok = ok && (jobs > 1 ? Schema::check(dialect, target, jobs, expected)
+                         : Schema::check(dialect, hStmt, expected));
+    // a database checked against the manifest can be reused by run
+    if (ok && expected)
+        ok = Schema::writeFingerprint(dialect, hStmt, manifest.digest());
+    SQLFreeHandle(SQL_HANDLE_STMT, hStmt);
+    SQLDisconnect(hDBC);
+    SQLFreeHandle(SQL_HANDLE_DBC, hDBC);
+    return ok ? 0 : 1;
+}
+
+// Finishes gen without --load by writing the manifest into outDir. Appended
+// warehouses extend the manifest already there, as long as they continue its
+// range with the same seed; otherwise the manifest covers only them, and run
+// --deep-check rejects it.
+static int finishFiles(const char* outDir, bool append, Manifest& manifest) {
+    std::string path = std::string(outDir) + "/" + manifestFileName;
+    Manifest existing;
+    if (append && existing.read(path) && existing.append(manifest)) {
+        return existing.write(path) ? 0 : 1;
+    }
+    return manifest.write(path) ? 0 : 1;
+}
+
+static int gen(int argc, char* argv[]) {
+    int longopt_idx;
+    static struct option longOpts[] = {
+        {"warehouses", required_argument, nullptr, 'w'},
+        {"out-dir", required_argument, nullptr, 'o'},
+        {"jobs", required_argument, nullptr, 'j'},
+        {"seed", required_argument, nullptr, 's'},
+        {"dsn", required_argument, nullptr, 'd'},
+        {"username", required_argument, nullptr, 'u'},
+        {"password", required_argument, nullptr, 'p'},
+        {"config-file-path", required_argument, &longopt_idx, CONFIG_FILE_PATH},
+        {"load", no_argument, &longopt_idx, LOAD},
+        {"compress", no_argument, &longopt_idx, COMPRESS},
+        {"format", required_argument, &longopt_idx, FORMAT},
+        {"from-warehouse", required_argument, &longopt_idx, FROM_WAREHOUSE},
+        {"to-warehouse", required_argument, &longopt_idx, TO_WAREHOUSE},
+        {"simulated-time", required_argument, &longopt_idx, SIMULATED_TIME},
+        {"copy-url", required_argument, &longopt_idx, COPY_URL},
+        {"partitions", required_argument, &longopt_idx, PARTITIONS},
+        {nullptr, 0, nullptr, 0}};
+
+    int c;
+    int firstWId = 1;
+    int lastWId = 1;
+    int jobs = 1;
+    int partitions = 0;
+    const char* outDir = "gen";
+    bool load = false;
+    bool compress = false;
+    OutputFormat format = OutputFormat::text;
+    LoadTarget target = {nullptr, nullptr, nullptr, nullptr, nullptr};
+    std::optional<mz::Config> config;
+    while ((c = getopt_long(argc, argv, "w:o:j:s:d:u:p:", longOpts, nullptr)) != -1) {
+        if (c == 0) switch (longopt_idx) {
+        case CONFIG_FILE_PATH: {
+            libconfig::Config lc_config;
+            lc_config.readFile(optarg);
+            config = Config::get_config(lc_config);
+            break;
+        }
+        case LOAD:
+            load = true;
+            break;
+        case COMPRESS:
+            compress = true;
+            break;
+        case FORMAT:
+            if (strcmp(optarg, "text") == 0)
+                format = OutputFormat::text;
+            else if (strcmp(optarg, "columnar") == 0)
+                format = OutputFormat::columnar;
+            else
+                errx(1, "unknown output format %s", optarg);
+            break;
+        case FROM_WAREHOUSE:
+            firstWId = parseInt("first warehouse", optarg);
+            break;
+        case TO_WAREHOUSE:
+            lastWId = parseInt("last warehouse", optarg);
+            break;
+        case SIMULATED_TIME:
+            Clock::simulate(parseUint64("simulated time", optarg));
+            break;
+        case COPY_URL:
+            target.copyUrl = optarg;
+            break;
+        case PARTITIONS:
+            partitions = parseInt("partitions", optarg);
+            break;
+        default:
+            return 1;
+        } else switch (c) {
+        case 'w':
+            lastWId = parseInt("warehouse count", optarg);
+            break;
+        case 'o':
+            outDir = optarg;
+            break;
+        case 'j':
+            jobs = parseInt("gen jobs", optarg);
+            break;
+        case 's':
+            chRandom::setSeed(parseUint64("seed", optarg));
+            break;
+        case 'd':
+            target.dsn = optarg;
+            break;
+        case 'u':
+            target.username = optarg;
+            break;
+        case 'p':
+            target.password = optarg;
+            break;
+        default:
+            return 1;
+        }
+    }
+    if (!config) {
+        config = mz::defaultConfig();
+    }
+    mz::Config mzCfg = std::move(*config);
+    argc -= optind;
+    argv += optind;
+
+    if (firstWId < 1) {
+        errx(1, "first warehouse must be greater than zero");
+    }
+    if (lastWId < firstWId) {
+        errx(1, "last warehouse cannot be less than the first warehouse");
+    }
+    // Starting past warehouse 1 appends warehouses to an existing dataset,
+    // which already holds the fixed-size tables.
+    bool append = firstWId > 1;
+    int warehouseCount = lastWId - firstWId + 1;
+    if (jobs < 1) {
+        errx(1, "gen jobs must be greater than zero");
+    }
+    if (jobs > warehouseCount) {
+        jobs = warehouseCount;
+    }
+    // The warehouse range is written as one shard per partition, or per job
+    // without --partitions.
+    int shards = jobs;
+    if (partitions) {
+        if (partitions < 1)
+            errx(1, "partitions must be greater than zero");
+        if (load)
+            errx(1, "--partitions requires files, so it does not take --load");
+        if (append)
+            errx(1, "--partitions requires a dataset from warehouse 1");
+        shards = std::min(partitions, warehouseCount);
+        jobs = std::min(jobs, shards);
+    }
+    if (load && !target.dsn) {
+        errx(1, "--load requires a data source name (DSN)");
+    }
+    if (load && (compress || format != OutputFormat::text)) {
+        errx(1, "--load does not write files, so it takes no output format");
+    }
+    if (target.copyUrl && !load) {
+        errx(1, "--copy-url requires --load");
+    }
+    if (target.copyUrl && mzCfg.dialect->getCopyStatements().empty()) {
+        errx(1, "--copy-url requires a dialect with COPY support");
+    }
+    if (compress) {
+        if (format == OutputFormat::columnar)
+            errx(1, "--compress only applies to the text format");
+        format = OutputFormat::gzip;
+    }
+
+    DataSource::initialize(lastWId);
+
+    // With --load, nothing is written to outDir. Instead the schema is
+    // created up front, unless appending to it, and every table gets its own
+    // loader connection, so the warehouse-scoped tables of each job are
+    // ingested concurrently.
+    SQLHDBC hDBC = nullptr;
+    SQLHSTMT hStmt = nullptr;
+    if (load) {
+        DbcTools::setEnv(target.hEnv);
+        if (!DbcTools::connect(target.hEnv, hDBC, target.dsn, target.username,
+                               target.password)) {
+            return 1;
+        }
+        SQLAllocHandle(SQL_HANDLE_STMT, hDBC, &hStmt);
+        if (!append) {
+            Log::l2() << Log::tm() << "Schema creation:\n";
+            if (!Schema::createSchema(mzCfg.dialect, hStmt)) {
+                return 1;
+            }
+        } else {
+            // appended warehouses change the dataset that was fingerprinted
+            Schema::writeFingerprint(mzCfg.dialect, hStmt, "");
+        }
+        Log::l2() << Log::tm() << "Streaming load:\n";
+    }
+
+    // Every table's rows are counted and checksummed as they are generated.
+    Manifest manifest;
+    manifest.seed = chRandom::seedKey;
+    manifest.firstWarehouse = firstWId;
+    manifest.lastWarehouse = lastWId;
+    // run --partition partitions the tables like the shards.
+    if (!load && !append && shards > 1)
+        manifest.partitions = shards;
+
+    // C_SINCE is the time at which the CUSTOMER table was populated, shared
+    // by every customer row.
+    char customerTime[Clock::timestampLength + 1];
+    Clock::format(0, customerTime);
+
+    // An appended dataset leaves out ITEM, NATION, SUPPLIER and REGION. Their
+    // files are removed, so that the output directory cannot be mistaken for
+    // a complete dataset.
+    if (append && !load) {
+        for (int i = 0; i < tableCount; i++) {
+            auto t = static_cast<Table>(i);
+            if (!isWarehouseScoped(t))
+                TupleGen::removeOutputFiles(outDir, t, "");
+        }
+    }
+
+    if (shards == 1) {
+        TupleGen tg;
+        tg.recordInto(&manifest);
+        if (load) {
+            openLoaders(tg, true, target, mzCfg.dialect);
+            if (!append)
+                openLoaders(tg, false, target, mzCfg.dialect);
+        } else {
+            TupleGen::removeStaleShards(outDir, 0);
+            tg.openWarehouseOutputFiles(outDir, "", format);
+            if (!append)
+                tg.openFixedOutputFiles(outDir, format);
+        }
+        genWarehouses(tg, firstWId, lastWId, customerTime, mzCfg);
+        if (!append)
+            genFixed(tg, mzCfg);
+        tg.closeOutputFiles();
+        return load ? finishLoad(mzCfg.dialect, hDBC, hStmt, !append,
+                                 target, jobs, manifest)
+                    : finishFiles(outDir, append, manifest);
+    }
+
+    // Split the warehouse range into contiguous shards, which the jobs take
+    // one at a time. Each shard is written to its own <table>.tbl.<shard>
+    // files, while the fixed-size tables are generated once on this thread.
+    if (!load) {
+        TupleGen::removeStaleShards(outDir, shards);
+        for (int i = 0; i < tableCount; i++) {
+            auto t = static_cast<Table>(i);
+            if (isWarehouseScoped(t))
+                TupleGen::removeOutputFiles(outDir, t, "");
+        }
+    }
+
+    std::vector<int> bounds = partitionBounds(firstWId, lastWId, shards);
+    std::atomic<int> nextShard(0);
+    std::vector<std::thread> workers;
+    workers.reserve(jobs);
+    for (int job = 0; job < jobs; job++) {
+        // Each job gets its own copy of the config, as the distributions in
+        // it are not safe to share between threads.
+        workers.emplace_back([=, &customerTime, &manifest, &bounds,
+                              &nextShard]() mutable {
+            TupleGen tg;
+            tg.recordInto(&manifest);
+            if (load)
+                openLoaders(tg, true, target, mzCfg.dialect);
+            for (int shard; (shard = nextShard++) < shards;) {
+                int fromWId = shard ? bounds[shard - 1] + 1 : firstWId;
+                if (!load)
+                    tg.openWarehouseOutputFiles(outDir, shardSuffix(shard),
+                                                format);
+                genWarehouses(tg, fromWId, bounds[shard], customerTime,
+                              mzCfg);
+                if (!load)
+                    tg.closeOutputFiles();
+            }
+            if (load)
+                tg.closeOutputFiles();
+        });
+    }
+
+    if (!append) {
+        TupleGen tg;
+        tg.recordInto(&manifest);
+        if (load)
+            openLoaders(tg, false, target, mzCfg.dialect);
+        else
+            tg.openFixedOutputFiles(outDir, format);
+        genFixed(tg, mzCfg);
+        tg.closeOutputFiles();
+    }
+
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    return load ? finishLoad(mzCfg.dialect, hDBC, hStmt, !append, target,
+                             jobs, manifest)
+                : finishFiles(outDir, append, manifest);
 }
 int main(int argc, char* argv[]) {
     for (int i = 1; i < argc; ++i) {
@@ -18,6 +18,9 @@ limitations under the License.
 #ifndef DIALECTBASIS_H
 #define DIALECTBASIS_H
 
+#include "Tables.h"
+
+#include <string>
 #include <vector>
 
 class Dialect {
@@ -28,8 +31,27 @@ class Dialect {
     // Strings to create initial database
     virtual std::vector<const char*>& getDropExistingSchemaStatements() = 0;
     virtual std::vector<const char*>& getCreateSchemaStatements() = 0;
+    // Primary keys and indexes, one list per table in import order. They
+    // are created after the import, the lists of different tables
+    // concurrently, the statements of one list in order.
+    virtual std::vector<std::vector<const char*>>& getCreateIndexStatements() = 0;
     virtual std::vector<const char*>& getImportPrefix() = 0;
     virtual std::vector<const char*>& getImportSuffix() = 0;
+    // Parameterized single-row INSERT per table, used by gen --load
+    virtual std::vector<const char*>& getInsertStatements() = 0;
+    // COPY ... FROM STDIN per table, used by --copy-url. Empty if the
+    // database does not speak the PostgreSQL COPY protocol.
+    virtual std::vector<const char*>& getCopyStatements() = 0;
+    // Snapshot of the tables that the transactions modify, for run --reset:
+    // statements to drop it, whose errors are ignored, to take it, and to
+    // reset the tables to it
+    virtual std::vector<const char*>& getDropSnapshotStatements() = 0;
+    virtual std::vector<const char*>& getSnapshotStatements() = 0;
+    virtual std::vector<const char*>& getRestoreStatements() = 0;
+    // Queries that fail unless every table of the snapshot exists, and
+    // whether the restore statements can run in a single transaction
+    virtual std::vector<const char*>& getSnapshotCheckStatements() = 0;
+    virtual bool isRestoreTransactional() = 0;
     virtual std::vector<const char*>& getAdditionalPreparationStatements() = 0;
 
     // 22 adjusted TPC-H OLAP query strings
@@ -37,6 +59,7 @@ class Dialect {
 
     // Strings for database check
     virtual const char* getSelectCountWarehouse() = 0;
+    virtual const char* getSelectMaxWarehouse() = 0;
     virtual const char* getSelectCountDistrict() = 0;
     virtual const char* getSelectCountCustomer() = 0;
     virtual const char* getSelectCountOrder() = 0;
@@ -48,6 +71,34 @@ class Dialect {
     virtual const char* getSelectCountSupplier() = 0;
     virtual const char* getSelectCountNation() = 0;
     virtual const char* getSelectCountRegion() = 0;
+    // select count(*), sum(<checksum column>) per table, in import order
+    virtual std::vector<const char*>& getChecksumStatements() = 0;
+
+    // Strings for the fingerprint table, which the schema creates and which
+    // holds the digest of the manifest of the checked, unmodified data
+    virtual const char* getDeleteFingerprint() = 0;
+    // INSERT of the digest, which goes between this prefix and "')"
+    virtual const char* getInsertFingerprintPrefix() = 0;
+    virtual const char* getSelectFingerprint() = 0;
+
+    // Strings for the load progress table, which the schema creates and into
+    // which a chunked import records every chunk it commits. The file name
+    // goes between the prefixes and "', <chunk>, <rows>)" or "'".
+    virtual const char* getInsertProgressPrefix() = 0;
+    virtual const char* getSelectProgressPrefix() = 0;
+    virtual const char* getDeleteProgress() = 0;
+
+    // Partitioning of the warehouse-scoped tables by ranges of warehouse ids
+    // (run --partition): statements that partition the empty table t, whose
+    // partition p ends with warehouse lastWarehouses[p] and whose last
+    // partition is open-ended, so that appended warehouses fit in
+    virtual std::vector<std::string>
+    getPartitionStatements(Table t, const std::vector<int>& lastWarehouses) = 0;
+    // Import prefix and suffix, and COPY statement if any, that load rows
+    // into partition p of table t directly, where the database allows that
+    virtual std::string getPartitionImportPrefix(Table t, int p) = 0;
+    virtual std::string getPartitionImportSuffix(Table t, int p) = 0;
+    virtual std::string getPartitionCopyStatement(Table t, int p) = 0;
 
     // TPC-C transaction strings
     // NewOrder:
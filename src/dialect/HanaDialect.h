@@ -38,8 +38,7 @@ class HanaDialect : public Dialect {
         "	\"W_STATE\" CHAR(2) CS_FIXEDSTRING,\n"
         "	\"W_ZIP\" CHAR(9) CS_FIXEDSTRING,\n"
         "	\"W_TAX\" DECIMAL(4,4) CS_FIXED,\n"
-        "	\"W_YTD\" DECIMAL(12,2) CS_FIXED,\n"
-        "	PRIMARY KEY (\"W_ID\")\n"
+        "	\"W_YTD\" DECIMAL(12,2) CS_FIXED\n"
         ") UNLOAD PRIORITY 5",
 
         "CREATE COLUMN TABLE \"TPCCH\".\"DISTRICT\" (\n"
@@ -53,13 +52,9 @@ class HanaDialect : public Dialect {
         "	\"D_ZIP\" CHAR(9) CS_FIXEDSTRING,\n"
         "	\"D_TAX\" DECIMAL(4,4) CS_FIXED,\n"
         "	\"D_YTD\" DECIMAL(12,2) CS_FIXED,\n"
-        "	\"D_NEXT_O_ID\" INTEGER CS_INT,\n"
-        "	PRIMARY KEY (\"D_W_ID\",\"D_ID\") \n"
+        "	\"D_NEXT_O_ID\" INTEGER CS_INT\n"
         ") UNLOAD PRIORITY 5",
 
-        "CREATE INDEX \"FK_DISTRICT_WAREHOUSE\" ON "
-        "\"TPCCH\".\"DISTRICT\" ( \"D_W_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
-
         "CREATE COLUMN TABLE \"TPCCH\".\"CUSTOMER\" (\n"
         "	\"C_ID\" SMALLINT CS_INT,\n"
         "	\"C_D_ID\" TINYINT CS_INT,\n"
@@ -82,16 +77,9 @@ class HanaDialect : public Dialect {
         "	\"C_PAYMENT_CNT\" SMALLINT CS_INT,\n"
         "	\"C_DELIVERY_CNT\" SMALLINT CS_INT,\n"
         "	\"C_DATA\" CHAR(500) CS_FIXEDSTRING,\n"
-        "	\"C_N_NATIONKEY\" INTEGER CS_INT,\n"
-        "	PRIMARY KEY(\"C_W_ID\",\"C_D_ID\",\"C_ID\")\n"
+        "	\"C_N_NATIONKEY\" INTEGER CS_INT\n"
         ") UNLOAD PRIORITY 5",
 
-        "ALTER TABLE \"TPCCH\".\"CUSTOMER\" WITH PARAMETERS "
-        "('CONCAT_ATTRIBUTE'=('$C_W_ID$C_D_ID$','C_W_ID','C_D_ID'))",
-
-        "CREATE INDEX \"FK_CUSTOMER_DISTRICT\" ON \"TPCCH\".\"CUSTOMER\" "
-        "( \"C_W_ID\" ASC,\"C_D_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
-
         "CREATE COLUMN TABLE \"TPCCH\".\"HISTORY\" (\n"
         "	\"H_C_ID\" SMALLINT CS_INT,\n"
         "	\"H_C_D_ID\" TINYINT CS_INT,\n"
@@ -103,23 +91,10 @@ class HanaDialect : public Dialect {
         "	\"H_DATA\" CHAR(24) CS_FIXEDSTRING\n"
         ") UNLOAD PRIORITY 5",
 
-        "ALTER TABLE \"TPCCH\".\"HISTORY\" WITH PARAMETERS ('CONCAT_ATTRIBUTE'="
-        "('$H_C_W_ID$H_C_D_ID$H_C_ID$','H_C_W_ID','H_C_D_ID','H_C_ID'))",
-
-        "ALTER TABLE \"TPCCH\".\"HISTORY\" WITH PARAMETERS ('CONCAT_ATTRIBUTE'="
-        "('$H_W_ID$H_D_ID$','H_W_ID','H_D_ID'))",
-
-        "CREATE INDEX \"FK_HISTORY_CUSTOMER\" ON \"TPCCH\".\"HISTORY\" "
-        "( \"H_C_W_ID\" ASC,\"H_C_D_ID\" ASC,\"H_C_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
-
-        "CREATE INDEX \"FK_HISTORY_DISTRICT\" ON \"TPCCH\".\"HISTORY\" "
-        "( \"H_W_ID\" ASC,\"H_D_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
-
         "CREATE COLUMN TABLE \"TPCCH\".\"NEWORDER\" (\n"
         "	\"NO_O_ID\" INTEGER CS_INT,\n"
         "	\"NO_D_ID\" TINYINT CS_INT,\n"
-        "	\"NO_W_ID\" INTEGER CS_INT,\n"
-        "	PRIMARY KEY (\"NO_W_ID\",\"NO_D_ID\",\"NO_O_ID\")\n"
+        "	\"NO_W_ID\" INTEGER CS_INT\n"
         ") UNLOAD PRIORITY 5",
 
         "CREATE COLUMN TABLE \"TPCCH\".\"ORDER\" (\n"
@@ -130,16 +105,9 @@ class HanaDialect : public Dialect {
         "	\"O_ENTRY_D\" SECONDDATE CS_SECONDDATE,\n"
         "	\"O_CARRIER_ID\" TINYINT CS_INT,\n"
         "	\"O_OL_CNT\" TINYINT CS_INT,\n"
-        "	\"O_ALL_LOCAL\" TINYINT CS_INT,\n"
-        "	PRIMARY KEY (\"O_W_ID\",\"O_D_ID\",\"O_ID\")\n"
+        "	\"O_ALL_LOCAL\" TINYINT CS_INT\n"
         ") UNLOAD PRIORITY 5",
 
-        "ALTER TABLE \"TPCCH\".\"ORDER\" WITH PARAMETERS "
-        "('CONCAT_ATTRIBUTE'=('$O_W_ID$O_D_ID$O_C_ID$','O_W_ID','O_D_ID','O_C_ID'))",
-
-        "CREATE INDEX \"FK_ORDER_CUSTOMER\" ON \"TPCCH\".\"ORDER\" "
-        "( \"O_W_ID\" ASC,\"O_D_ID\" ASC,\"O_C_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
-
         "CREATE COLUMN TABLE \"TPCCH\".\"ORDERLINE\" (\n"
         "	\"OL_O_ID\" INTEGER CS_INT,\n"
         "	\"OL_D_ID\" TINYINT CS_INT,\n"
@@ -150,29 +118,15 @@ class HanaDialect : public Dialect {
         "	\"OL_DELIVERY_D\" SECONDDATE CS_SECONDDATE,\n"
         "	\"OL_QUANTITY\" SMALLINT CS_INT,\n"
         "	\"OL_AMOUNT\" DECIMAL(6,2) CS_FIXED,\n"
-        "	\"OL_DIST_INFO\" CHAR(24) CS_FIXEDSTRING,\n"
-        "	PRIMARY KEY(\"OL_W_ID\",\"OL_D_ID\",\"OL_O_ID\",\"OL_NUMBER\")\n"
+        "	\"OL_DIST_INFO\" CHAR(24) CS_FIXEDSTRING\n"
         ") UNLOAD PRIORITY 5",
 
-        "ALTER TABLE \"TPCCH\".\"ORDERLINE\" WITH PARAMETERS "
-        "('CONCAT_ATTRIBUTE'=('$OL_W_ID$OL_D_ID$OL_O_ID$','OL_W_ID','OL_D_ID','OL_O_ID'))",
-
-        "ALTER TABLE \"TPCCH\".\"ORDERLINE\" WITH PARAMETERS "
-        "('CONCAT_ATTRIBUTE'=('$OL_SUPPLY_W_ID$OL_I_ID$','OL_SUPPLY_W_ID','OL_I_ID'))",
-
-        "CREATE INDEX \"FK_ORDERLINE_ORDER\" ON \"TPCCH\".\"ORDERLINE\" "
-        "( \"OL_W_ID\" ASC,\"OL_D_ID\" ASC,\"OL_O_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
-
-        "CREATE INDEX \"FK_ORDERLINE_STOCK\" ON \"TPCCH\".\"ORDERLINE\" "
-        "( \"OL_SUPPLY_W_ID\" ASC,\"OL_I_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
-
         "CREATE COLUMN TABLE \"TPCCH\".\"ITEM\" (\n"
         "	\"I_ID\" INTEGER CS_INT,\n"
         "	\"I_IM_ID\" SMALLINT CS_INT,\n"
         "	\"I_NAME\" CHAR(24) CS_FIXEDSTRING,\n"
         "	\"I_PRICE\" DECIMAL(5,2) CS_FIXED,\n"
-        "	\"I_DATA\" CHAR(50) CS_FIXEDSTRING,\n"
-        "	PRIMARY KEY(\"I_ID\")\n"
+        "	\"I_DATA\" CHAR(50) CS_FIXEDSTRING\n"
         ") UNLOAD PRIORITY 5",
 
         "CREATE COLUMN TABLE \"TPCCH\".\"STOCK\" (\n"
@@ -193,22 +147,14 @@ class HanaDialect : public Dialect {
         "	\"S_ORDER_CNT\" SMALLINT CS_INT,\n"
         "	\"S_REMOTE_CNT\" SMALLINT CS_INT,\n"
         "	\"S_DATA\" CHAR(50) CS_FIXEDSTRING,\n"
-        "	\"S_SU_SUPPKEY\" INTEGER CS_INT,\n"
-        "	PRIMARY KEY (\"S_W_ID\",\"S_I_ID\")\n"
+        "	\"S_SU_SUPPKEY\" INTEGER CS_INT\n"
         ") UNLOAD PRIORITY 5",
 
-        "CREATE INDEX \"FK_STOCK_WAREHOUSE\" ON \"TPCCH\".\"STOCK\" "
-        "( \"S_W_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
-
-        "CREATE INDEX \"FK_STOCK_ITEM\" ON \"TPCCH\".\"STOCK\" "
-        "( \"S_I_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
-
         "CREATE COLUMN TABLE \"TPCCH\".\"NATION\" (\n"
         "	\"N_NATIONKEY\" TINYINT CS_INT NOT NULL,\n"
         "	\"N_NAME\" CHAR(25) CS_FIXEDSTRING NOT NULL,\n"
         "	\"N_REGIONKEY\" TINYINT CS_INT NOT NULL,\n"
-        "	\"N_COMMENT\" CHAR(152) CS_FIXEDSTRING NOT NULL,\n"
-        "	PRIMARY KEY (\"N_NATIONKEY\")\n"
+        "	\"N_COMMENT\" CHAR(152) CS_FIXEDSTRING NOT NULL\n"
         ") UNLOAD PRIORITY 5",
 
         "CREATE COLUMN TABLE \"TPCCH\".\"SUPPLIER\" (\n"
@@ -218,16 +164,143 @@ class HanaDialect : public Dialect {
         "	\"SU_NATIONKEY\"TINYINT CS_INT NOT NULL,\n"
         "	\"SU_PHONE\" CHAR(15) CS_FIXEDSTRING NOT NULL,\n"
         "	\"SU_ACCTBAL\" DECIMAL(12,2) CS_FIXED NOT NULL,\n"
-        "	\"SU_COMMENT\" CHAR(101) CS_FIXEDSTRING NOT NULL,\n"
-        "	PRIMARY KEY(\"SU_SUPPKEY\")\n"
+        "	\"SU_COMMENT\" CHAR(101) CS_FIXEDSTRING NOT NULL\n"
         ") UNLOAD PRIORITY 5",
 
         "CREATE COLUMN TABLE \"TPCCH\".\"REGION\" (\n"
         "	\"R_REGIONKEY\" TINYINT CS_INT NOT NULL,\n"
         "	\"R_NAME\" CHAR(55) CS_FIXEDSTRING NOT NULL,\n"
-        "	\"R_COMMENT\" CHAR(152) CS_FIXEDSTRING NOT NULL,\n"
-        "	PRIMARY KEY (\"R_REGIONKEY\")\n"
-        ") UNLOAD PRIORITY 5"};
+        "	\"R_COMMENT\" CHAR(152) CS_FIXEDSTRING NOT NULL\n"
+        ") UNLOAD PRIORITY 5",
+
+        "CREATE COLUMN TABLE \"TPCCH\".\"FINGERPRINT\" (\n"
+        "	\"FP_DIGEST\" CHAR(16) CS_FIXEDSTRING NOT NULL\n"
+        ")",
+
+        "CREATE COLUMN TABLE \"TPCCH\".\"LOAD_PROGRESS\" (\n"
+        "	\"LP_FILE\" VARCHAR(255) NOT NULL,\n"
+        "	\"LP_CHUNK\" INTEGER CS_INT NOT NULL,\n"
+        "	\"LP_ROWS\" INTEGER CS_INT NOT NULL\n"
+        ")"};
+
+    // Keys, concat attributes and indexes, per table in import order, built
+    // after the import.
+    std::vector<std::vector<const char*>> createIndexStatements = {
+        {"ALTER TABLE \"TPCCH\".\"WAREHOUSE\" ADD PRIMARY KEY (\"W_ID\")"},
+
+        {"ALTER TABLE \"TPCCH\".\"DISTRICT\" ADD PRIMARY KEY (\"D_W_ID\",\"D_ID\")",
+
+         "CREATE INDEX \"FK_DISTRICT_WAREHOUSE\" ON "
+         "\"TPCCH\".\"DISTRICT\" ( \"D_W_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1"},
+
+        {"ALTER TABLE \"TPCCH\".\"CUSTOMER\" "
+         "ADD PRIMARY KEY (\"C_W_ID\",\"C_D_ID\",\"C_ID\")",
+
+         "ALTER TABLE \"TPCCH\".\"CUSTOMER\" WITH PARAMETERS "
+         "('CONCAT_ATTRIBUTE'=('$C_W_ID$C_D_ID$','C_W_ID','C_D_ID'))",
+
+         "CREATE INDEX \"FK_CUSTOMER_DISTRICT\" ON \"TPCCH\".\"CUSTOMER\" "
+         "( \"C_W_ID\" ASC,\"C_D_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1"},
+
+        {"ALTER TABLE \"TPCCH\".\"HISTORY\" WITH PARAMETERS ('CONCAT_ATTRIBUTE'="
+         "('$H_C_W_ID$H_C_D_ID$H_C_ID$','H_C_W_ID','H_C_D_ID','H_C_ID'))",
+
+         "ALTER TABLE \"TPCCH\".\"HISTORY\" WITH PARAMETERS ('CONCAT_ATTRIBUTE'="
+         "('$H_W_ID$H_D_ID$','H_W_ID','H_D_ID'))",
+
+         "CREATE INDEX \"FK_HISTORY_CUSTOMER\" ON \"TPCCH\".\"HISTORY\" "
+         "( \"H_C_W_ID\" ASC,\"H_C_D_ID\" ASC,\"H_C_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
+
+         "CREATE INDEX \"FK_HISTORY_DISTRICT\" ON \"TPCCH\".\"HISTORY\" "
+         "( \"H_W_ID\" ASC,\"H_D_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1"},
+
+        {"ALTER TABLE \"TPCCH\".\"NEWORDER\" "
+         "ADD PRIMARY KEY (\"NO_W_ID\",\"NO_D_ID\",\"NO_O_ID\")"},
+
+        {"ALTER TABLE \"TPCCH\".\"ORDER\" "
+         "ADD PRIMARY KEY (\"O_W_ID\",\"O_D_ID\",\"O_ID\")",
+
+         "ALTER TABLE \"TPCCH\".\"ORDER\" WITH PARAMETERS "
+         "('CONCAT_ATTRIBUTE'=('$O_W_ID$O_D_ID$O_C_ID$','O_W_ID','O_D_ID','O_C_ID'))",
+
+         "CREATE INDEX \"FK_ORDER_CUSTOMER\" ON \"TPCCH\".\"ORDER\" "
+         "( \"O_W_ID\" ASC,\"O_D_ID\" ASC,\"O_C_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1"},
+
+        {"ALTER TABLE \"TPCCH\".\"ORDERLINE\" "
+         "ADD PRIMARY KEY (\"OL_W_ID\",\"OL_D_ID\",\"OL_O_ID\",\"OL_NUMBER\")",
+
+         "ALTER TABLE \"TPCCH\".\"ORDERLINE\" WITH PARAMETERS "
+         "('CONCAT_ATTRIBUTE'=('$OL_W_ID$OL_D_ID$OL_O_ID$','OL_W_ID','OL_D_ID','OL_O_ID'))",
+
+         "ALTER TABLE \"TPCCH\".\"ORDERLINE\" WITH PARAMETERS "
+         "('CONCAT_ATTRIBUTE'=('$OL_SUPPLY_W_ID$OL_I_ID$','OL_SUPPLY_W_ID','OL_I_ID'))",
+
+         "CREATE INDEX \"FK_ORDERLINE_ORDER\" ON \"TPCCH\".\"ORDERLINE\" "
+         "( \"OL_W_ID\" ASC,\"OL_D_ID\" ASC,\"OL_O_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
+
+         "CREATE INDEX \"FK_ORDERLINE_STOCK\" ON \"TPCCH\".\"ORDERLINE\" "
+         "( \"OL_SUPPLY_W_ID\" ASC,\"OL_I_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1"},
+
+        {"ALTER TABLE \"TPCCH\".\"ITEM\" ADD PRIMARY KEY (\"I_ID\")"},
+
+        {"ALTER TABLE \"TPCCH\".\"STOCK\" ADD PRIMARY KEY (\"S_W_ID\",\"S_I_ID\")",
+
+         "CREATE INDEX \"FK_STOCK_WAREHOUSE\" ON \"TPCCH\".\"STOCK\" "
+         "( \"S_W_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1",
+
+         "CREATE INDEX \"FK_STOCK_ITEM\" ON \"TPCCH\".\"STOCK\" "
+         "( \"S_I_ID\" ASC ) NONLEAF PARTIAL KEY LENGTH 1"},
+
+        {"ALTER TABLE \"TPCCH\".\"NATION\" ADD PRIMARY KEY (\"N_NATIONKEY\")"},
+
+        {"ALTER TABLE \"TPCCH\".\"SUPPLIER\" ADD PRIMARY KEY (\"SU_SUPPKEY\")"},
+
+        {"ALTER TABLE \"TPCCH\".\"REGION\" ADD PRIMARY KEY (\"R_REGIONKEY\")"}};
+
+    // Copies of the tables that the transactions modify, taken after the
+    // load, and the statements that reset the tables to them.
+    std::vector<const char*> dropSnapshotStatements = {
+        "DROP SCHEMA \"TPCCH_SNAPSHOT\" CASCADE"};
+
+    std::vector<const char*> snapshotStatements = {
+        "CREATE SCHEMA \"TPCCH_SNAPSHOT\"",
+        "CREATE COLUMN TABLE \"TPCCH_SNAPSHOT\".\"WAREHOUSE\" AS (SELECT * FROM \"TPCCH\".\"WAREHOUSE\")",
+        "CREATE COLUMN TABLE \"TPCCH_SNAPSHOT\".\"DISTRICT\" AS (SELECT * FROM \"TPCCH\".\"DISTRICT\")",
+        "CREATE COLUMN TABLE \"TPCCH_SNAPSHOT\".\"CUSTOMER\" AS (SELECT * FROM \"TPCCH\".\"CUSTOMER\")",
+        "CREATE COLUMN TABLE \"TPCCH_SNAPSHOT\".\"HISTORY\" AS (SELECT * FROM \"TPCCH\".\"HISTORY\")",
+        "CREATE COLUMN TABLE \"TPCCH_SNAPSHOT\".\"NEWORDER\" AS (SELECT * FROM \"TPCCH\".\"NEWORDER\")",
+        "CREATE COLUMN TABLE \"TPCCH_SNAPSHOT\".\"ORDER\" AS (SELECT * FROM \"TPCCH\".\"ORDER\")",
+        "CREATE COLUMN TABLE \"TPCCH_SNAPSHOT\".\"ORDERLINE\" AS (SELECT * FROM \"TPCCH\".\"ORDERLINE\")",
+        "CREATE COLUMN TABLE \"TPCCH_SNAPSHOT\".\"STOCK\" AS (SELECT * FROM \"TPCCH\".\"STOCK\")"};
+
+    std::vector<const char*> restoreStatements = {
+        "TRUNCATE TABLE \"TPCCH\".\"WAREHOUSE\"",
+        "TRUNCATE TABLE \"TPCCH\".\"DISTRICT\"",
+        "TRUNCATE TABLE \"TPCCH\".\"CUSTOMER\"",
+        "TRUNCATE TABLE \"TPCCH\".\"HISTORY\"",
+        "TRUNCATE TABLE \"TPCCH\".\"NEWORDER\"",
+        "TRUNCATE TABLE \"TPCCH\".\"ORDER\"",
+        "TRUNCATE TABLE \"TPCCH\".\"ORDERLINE\"",
+        "TRUNCATE TABLE \"TPCCH\".\"STOCK\"",
+        "INSERT INTO \"TPCCH\".\"WAREHOUSE\" SELECT * FROM \"TPCCH_SNAPSHOT\".\"WAREHOUSE\"",
+        "INSERT INTO \"TPCCH\".\"DISTRICT\" SELECT * FROM \"TPCCH_SNAPSHOT\".\"DISTRICT\"",
+        "INSERT INTO \"TPCCH\".\"CUSTOMER\" SELECT * FROM \"TPCCH_SNAPSHOT\".\"CUSTOMER\"",
+        "INSERT INTO \"TPCCH\".\"HISTORY\" SELECT * FROM \"TPCCH_SNAPSHOT\".\"HISTORY\"",
+        "INSERT INTO \"TPCCH\".\"NEWORDER\" SELECT * FROM \"TPCCH_SNAPSHOT\".\"NEWORDER\"",
+        "INSERT INTO \"TPCCH\".\"ORDER\" SELECT * FROM \"TPCCH_SNAPSHOT\".\"ORDER\"",
+        "INSERT INTO \"TPCCH\".\"ORDERLINE\" SELECT * FROM \"TPCCH_SNAPSHOT\".\"ORDERLINE\"",
+        "INSERT INTO \"TPCCH\".\"STOCK\" SELECT * FROM \"TPCCH_SNAPSHOT\".\"STOCK\""};
+
+    // Read no rows, but fail if the table is missing.
+    std::vector<const char*> snapshotCheckStatements = {
+        "SELECT 1 FROM \"TPCCH_SNAPSHOT\".\"WAREHOUSE\" WHERE 1 = 0",
+        "SELECT 1 FROM \"TPCCH_SNAPSHOT\".\"DISTRICT\" WHERE 1 = 0",
+        "SELECT 1 FROM \"TPCCH_SNAPSHOT\".\"CUSTOMER\" WHERE 1 = 0",
+        "SELECT 1 FROM \"TPCCH_SNAPSHOT\".\"HISTORY\" WHERE 1 = 0",
+        "SELECT 1 FROM \"TPCCH_SNAPSHOT\".\"NEWORDER\" WHERE 1 = 0",
+        "SELECT 1 FROM \"TPCCH_SNAPSHOT\".\"ORDER\" WHERE 1 = 0",
+        "SELECT 1 FROM \"TPCCH_SNAPSHOT\".\"ORDERLINE\" WHERE 1 = 0",
+        "SELECT 1 FROM \"TPCCH_SNAPSHOT\".\"STOCK\" WHERE 1 = 0"};
 
     std::vector<const char*> additionalPreparationStatements = {
         "load TPCCH.\"WAREHOUSE\" all", "merge delta of TPCCH.\"WAREHOUSE\"",
@@ -253,18 +326,49 @@ class HanaDialect : public Dialect {
         "IMPORT FROM CSV FILE '", "IMPORT FROM CSV FILE '"};
 
     std::vector<const char*> importSuffixStrings = {
-        "/WAREHOUSE.tbl' INTO TPCCH.\"WAREHOUSE\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
-        "/DISTRICT.tbl' INTO TPCCH.\"DISTRICT\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
-        "/CUSTOMER.tbl' INTO TPCCH.\"CUSTOMER\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
-        "/HISTORY.tbl' INTO TPCCH.\"HISTORY\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
-        "/NEWORDER.tbl' INTO TPCCH.\"NEWORDER\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
-        "/ORDER.tbl' INTO TPCCH.\"ORDER\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
-        "/ORDERLINE.tbl' INTO TPCCH.\"ORDERLINE\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
-        "/ITEM.tbl' INTO TPCCH.\"ITEM\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
-        "/STOCK.tbl' INTO TPCCH.\"STOCK\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
-        "/NATION.tbl' INTO TPCCH.\"NATION\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
-        "/SUPPLIER.tbl' INTO TPCCH.\"SUPPLIER\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
-        "/REGION.tbl' INTO TPCCH.\"REGION\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK"};
+        "' INTO TPCCH.\"WAREHOUSE\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
+        "' INTO TPCCH.\"DISTRICT\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
+        "' INTO TPCCH.\"CUSTOMER\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
+        "' INTO TPCCH.\"HISTORY\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
+        "' INTO TPCCH.\"NEWORDER\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
+        "' INTO TPCCH.\"ORDER\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
+        "' INTO TPCCH.\"ORDERLINE\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
+        "' INTO TPCCH.\"ITEM\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
+        "' INTO TPCCH.\"STOCK\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
+        "' INTO TPCCH.\"NATION\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
+        "' INTO TPCCH.\"SUPPLIER\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK",
+        "' INTO TPCCH.\"REGION\" WITH RECORD DELIMITED BY '\n' FIELD DELIMITED BY '|' THREADS 10 TABLE LOCK"};
+
+    std::vector<const char*> copyStrings = {};
+
+    std::vector<const char*> insertStrings = {
+        "INSERT INTO TPCCH.\"WAREHOUSE\" VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO TPCCH.\"DISTRICT\" VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO TPCCH.\"CUSTOMER\" VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO TPCCH.\"HISTORY\" VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO TPCCH.\"NEWORDER\" VALUES (?, ?, ?)",
+        "INSERT INTO TPCCH.\"ORDER\" VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO TPCCH.\"ORDERLINE\" VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO TPCCH.\"ITEM\" VALUES (?, ?, ?, ?, ?)",
+        "INSERT INTO TPCCH.\"STOCK\" VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO TPCCH.\"NATION\" VALUES (?, ?, ?, ?)",
+        "INSERT INTO TPCCH.\"SUPPLIER\" VALUES (?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO TPCCH.\"REGION\" VALUES (?, ?, ?)"};
+
+    // Row count and checksum per table, see checksumField in Tables.h.
+    std::vector<const char*> checksumStrings = {
+        "select count(*), sum(\"W_ID\") from \"TPCCH\".\"WAREHOUSE\"",
+        "select count(*), sum(\"D_ID\") from \"TPCCH\".\"DISTRICT\"",
+        "select count(*), sum(\"C_N_NATIONKEY\") from \"TPCCH\".\"CUSTOMER\"",
+        "select count(*), sum(\"H_C_ID\") from \"TPCCH\".\"HISTORY\"",
+        "select count(*), sum(\"NO_O_ID\") from \"TPCCH\".\"NEWORDER\"",
+        "select count(*), sum(\"O_CARRIER_ID\") from \"TPCCH\".\"ORDER\"",
+        "select count(*), sum(\"OL_I_ID\") from \"TPCCH\".\"ORDERLINE\"",
+        "select count(*), sum(\"I_IM_ID\") from \"TPCCH\".\"ITEM\"",
+        "select count(*), sum(\"S_QUANTITY\") from \"TPCCH\".\"STOCK\"",
+        "select count(*), sum(\"N_REGIONKEY\") from \"TPCCH\".\"NATION\"",
+        "select count(*), sum(\"SU_NATIONKEY\") from \"TPCCH\".\"SUPPLIER\"",
+        "select count(*), sum(\"R_REGIONKEY\") from \"TPCCH\".\"REGION\""};
 
     std::vector<const char*> tpchQueryStrings = {
         // TPC-H-Query 1
@@ -785,6 +889,10 @@ class HanaDialect : public Dialect {
         return createSchemaStatements;
     }
 
+    virtual std::vector<std::vector<const char*>>& getCreateIndexStatements() {
+        return createIndexStatements;
+    }
+
     virtual std::vector<const char*>& getImportPrefix() {
         return importPrefixStrings;
     }
@@ -793,6 +901,33 @@ class HanaDialect : public Dialect {
         return importSuffixStrings;
     }
 
+    virtual std::vector<const char*>& getInsertStatements() {
+        return insertStrings;
+    }
+
+    virtual std::vector<const char*>& getCopyStatements() {
+        return copyStrings;
+    }
+
+    virtual std::vector<const char*>& getDropSnapshotStatements() {
+        return dropSnapshotStatements;
+    }
+
+    virtual std::vector<const char*>& getSnapshotStatements() {
+        return snapshotStatements;
+    }
+
+    virtual std::vector<const char*>& getRestoreStatements() {
+        return restoreStatements;
+    }
+
+    virtual std::vector<const char*>& getSnapshotCheckStatements() {
+        return snapshotCheckStatements;
+    }
+
+    // TRUNCATE TABLE is DDL, which commits on its own.
+    virtual bool isRestoreTransactional() { return false; }
+
     virtual std::vector<const char*>& getAdditionalPreparationStatements() {
         return additionalPreparationStatements;
     }
@@ -807,6 +942,10 @@ class HanaDialect : public Dialect {
         return "select count(*) from TPCCH.WAREHOUSE";
     }
 
+    virtual const char* getSelectMaxWarehouse() {
+        return "select max(W_ID) from TPCCH.WAREHOUSE";
+    }
+
     virtual const char* getSelectCountDistrict() {
         return "select count(*) from TPCCH.DISTRICT";
     }
@@ -851,6 +990,67 @@ class HanaDialect : public Dialect {
         return "select count(*) from TPCCH.REGION";
     }
 
+    virtual std::vector<const char*>& getChecksumStatements() {
+        return checksumStrings;
+    }
+
+    virtual const char* getDeleteFingerprint() {
+        return "DELETE FROM TPCCH.FINGERPRINT";
+    }
+
+    virtual const char* getInsertFingerprintPrefix() {
+        return "INSERT INTO TPCCH.FINGERPRINT VALUES ('";
+    }
+
+    virtual const char* getSelectFingerprint() {
+        return "SELECT FP_DIGEST FROM TPCCH.FINGERPRINT";
+    }
+
+    virtual const char* getInsertProgressPrefix() {
+        return "INSERT INTO TPCCH.LOAD_PROGRESS VALUES ('";
+    }
+
+    virtual const char* getSelectProgressPrefix() {
+        return "SELECT count(*), min(LP_ROWS), max(LP_ROWS)\n"
+               "FROM TPCCH.LOAD_PROGRESS WHERE LP_FILE = '";
+    }
+
+    virtual const char* getDeleteProgress() {
+        return "DELETE FROM TPCCH.LOAD_PROGRESS";
+    }
+
+    virtual std::vector<std::string>
+    getPartitionStatements(Table t, const std::vector<int>& lastWarehouses) {
+        std::string stmt = "ALTER TABLE \"TPCCH\".\"" + upper(tableName(t)) +
+                           "\" PARTITION BY RANGE (\"" +
+                           upper(warehouseColumnName(t)) + "\") (";
+        int from = 1;
+        for (size_t p = 0; p + 1 < lastWarehouses.size(); p++) {
+            stmt += "\n\tPARTITION " + std::to_string(from) +
+                    " <= VALUES < " + std::to_string(lastWarehouses[p] + 1) +
+                    ",";
+            from = lastWarehouses[p] + 1;
+        }
+        return {stmt + "\n\tPARTITION OTHERS)"};
+    }
+
+    // IMPORT cannot target a partition, so rows are routed by the table.
+    virtual std::string getPartitionImportPrefix(Table t, int) {
+        return importPrefixStrings[static_cast<int>(t)];
+    }
+
+    virtual std::string getPartitionImportSuffix(Table t, int) {
+        return importSuffixStrings[static_cast<int>(t)];
+    }
+
+    virtual std::string getPartitionCopyStatement(Table, int) { return ""; }
+
+    static std::string upper(std::string s) {
+        for (auto& c : s)
+            c = toupper(c);
+        return s;
+    }
+
     // TPC-C transaction strings
     // NewOrder:
     virtual const char* getNoWarehouseSelect() {
@@ -37,8 +37,7 @@ class MySqlDialect : public Dialect {
         "	w_state char(2),\n"
         "	w_zip char(9),\n"
         "	w_tax decimal(4,4),\n"
-        "	w_ytd decimal(12,2),\n"
-        "	PRIMARY KEY (w_id)\n"
+        "	w_ytd decimal(12,2)\n"
         ")",
 
         "CREATE TABLE tpcch.district (\n"
@@ -52,12 +51,9 @@ class MySqlDialect : public Dialect {
         "	d_zip char(9),\n"
         "	d_tax decimal(4,4),\n"
         "	d_ytd decimal(12,2),\n"
-        "	d_next_o_id integer,\n"
-        "	PRIMARY KEY (d_w_id, d_id) \n"
+        "	d_next_o_id integer\n"
         ")",
 
-        "CREATE INDEX fk_district_warehouse ON tpcch.district (d_w_id ASC)",
-
         "CREATE TABLE tpcch.customer (\n"
         "	c_id smallint,\n"
         "	c_d_id tinyint,\n"
@@ -80,13 +76,9 @@ class MySqlDialect : public Dialect {
         "	c_payment_cnt smallint,\n"
         "	c_delivery_cnt smallint,\n"
         "	c_data text,\n"
-        "	c_n_nationkey integer,\n"
-        "	PRIMARY KEY(c_w_id, c_d_id, c_id)\n"
+        "	c_n_nationkey integer\n"
         ")",
 
-        "CREATE INDEX fk_customer_district ON tpcch.customer"
-        "(c_w_id ASC, c_d_id ASC)",
-
         "CREATE TABLE tpcch.history (\n"
         "	h_c_id smallint,\n"
         "	h_c_d_id tinyint,\n"
@@ -98,17 +90,10 @@ class MySqlDialect : public Dialect {
         "	h_data char(24)\n"
         ")",
 
-        "CREATE INDEX fk_history_customer ON tpcch.history "
-        "(h_c_w_id ASC, h_c_d_id ASC, h_c_id ASC)",
-
-        "CREATE INDEX fk_history_district ON tpcch.history "
-        "(h_w_id ASC, h_d_id ASC)",
-
         "CREATE TABLE tpcch.neworder (\n"
         "	no_o_id integer,\n"
         "	no_d_id tinyint,\n"
-        "	no_w_id integer,\n"
-        "	PRIMARY KEY (no_w_id, no_d_id, no_o_id)\n"
+        "	no_w_id integer\n"
         ")",
 
         "CREATE TABLE tpcch.order (\n"
@@ -119,13 +104,9 @@ class MySqlDialect : public Dialect {
         "	o_entry_d date,\n"
         "	o_carrier_id tinyint,\n"
         "	o_ol_cnt tinyint,\n"
-        "	o_all_local tinyint,\n"
-        "	PRIMARY KEY (o_w_id, o_d_id, o_id)\n"
+        "	o_all_local tinyint\n"
         ")",
 
-        "CREATE INDEX fk_order_customer ON tpcch.order "
-        "(o_w_id ASC, o_d_id ASC, o_c_id ASC)",
-
         "CREATE TABLE tpcch.orderline (\n"
         "	ol_o_id integer,\n"
         "	ol_d_id tinyint,\n"
@@ -136,23 +117,15 @@ class MySqlDialect : public Dialect {
         "	ol_delivery_d date,\n"
         "	ol_quantity smallint,\n"
         "	ol_amount decimal(6,2),\n"
-        "	ol_dist_info char(24),\n"
-        "	PRIMARY KEY (ol_w_id, ol_d_id, ol_o_id, ol_number)\n"
+        "	ol_dist_info char(24)\n"
         ")",
 
-        "CREATE INDEX fk_orderline_order ON tpcch.orderline "
-        "(ol_w_id ASC, ol_d_id ASC, ol_o_id ASC)",
-
-        "CREATE INDEX fk_orderline_stock ON tpcch.orderline "
-        "(ol_supply_w_id ASC, ol_i_id ASC)",
-
         "CREATE TABLE tpcch.item (\n"
         "	i_id integer,\n"
         "	i_im_id smallint,\n"
         "	i_name char(24),\n"
         "	i_price decimal(5,2),\n"
-        "	i_data char(50),\n"
-        "	PRIMARY KEY (i_id)\n"
+        "	i_data char(50)\n"
         ")",
 
         "CREATE TABLE tpcch.stock (\n"
@@ -173,20 +146,14 @@ class MySqlDialect : public Dialect {
         "	s_order_cnt smallint,\n"
         "	s_remote_cnt smallint,\n"
         "	s_data char(50),\n"
-        "	s_su_suppkey integer,\n"
-        "	PRIMARY KEY (s_w_id, s_i_id)\n"
+        "	s_su_suppkey integer\n"
         ")",
 
-        "CREATE INDEX fk_stock_warehouse ON tpcch.stock (s_w_id ASC)",
-
-        "CREATE INDEX fk_stock_item ON tpcch.stock (s_i_id ASC)",
-
         "CREATE TABLE tpcch.nation (\n"
         "	n_nationkey tinyint NOT NULL,\n"
         "	n_name char(25) NOT NULL,\n"
         "	n_regionkey tinyint NOT NULL,\n"
-        "	n_comment char(152) NOT NULL,\n"
-        "	PRIMARY KEY (n_nationkey)\n"
+        "	n_comment char(152) NOT NULL\n"
         ")",
 
         "CREATE TABLE tpcch.supplier (\n"
@@ -196,17 +163,112 @@ class MySqlDialect : public Dialect {
         "	su_nationkey tinyint NOT NULL,\n"
         "	su_phone char(15) NOT NULL,\n"
         "	su_acctbal decimal(12,2) NOT NULL,\n"
-        "	su_comment char(101) NOT NULL,\n"
-        "	PRIMARY KEY (su_suppkey)\n"
+        "	su_comment char(101) NOT NULL\n"
         ")",
 
         "CREATE TABLE tpcch.region (\n"
         "	r_regionkey tinyint NOT NULL,\n"
         "	r_name char(55) NOT NULL,\n"
-        "	r_comment char(152) NOT NULL,\n"
-        "	PRIMARY KEY (r_regionkey)\n"
+        "	r_comment char(152) NOT NULL\n"
+        ")",
+
+        "CREATE TABLE tpcch.fingerprint (\n"
+        "	fp_digest char(16) NOT NULL\n"
+        ")",
+
+        "CREATE TABLE tpcch.load_progress (\n"
+        "	lp_file varchar(255) NOT NULL,\n"
+        "	lp_chunk int NOT NULL,\n"
+        "	lp_rows int NOT NULL\n"
         ")"};
 
+    // Keys and indexes, per table in import order, built after the import.
+    // Each table's are added by a single ALTER TABLE, so that InnoDB sorts
+    // and rebuilds the table once rather than once per index.
+    std::vector<std::vector<const char*>> createIndexStatements = {
+        {"ALTER TABLE tpcch.warehouse ADD PRIMARY KEY (w_id)"},
+
+        {"ALTER TABLE tpcch.district\n"
+         "	ADD PRIMARY KEY (d_w_id, d_id),\n"
+         "	ADD INDEX fk_district_warehouse (d_w_id ASC)"},
+
+        {"ALTER TABLE tpcch.customer\n"
+         "	ADD PRIMARY KEY (c_w_id, c_d_id, c_id),\n"
+         "	ADD INDEX fk_customer_district (c_w_id ASC, c_d_id ASC)"},
+
+        {"ALTER TABLE tpcch.history\n"
+         "	ADD INDEX fk_history_customer (h_c_w_id ASC, h_c_d_id ASC, h_c_id ASC),\n"
+         "	ADD INDEX fk_history_district (h_w_id ASC, h_d_id ASC)"},
+
+        {"ALTER TABLE tpcch.neworder ADD PRIMARY KEY (no_w_id, no_d_id, no_o_id)"},
+
+        {"ALTER TABLE tpcch.order\n"
+         "	ADD PRIMARY KEY (o_w_id, o_d_id, o_id),\n"
+         "	ADD INDEX fk_order_customer (o_w_id ASC, o_d_id ASC, o_c_id ASC)"},
+
+        {"ALTER TABLE tpcch.orderline\n"
+         "	ADD PRIMARY KEY (ol_w_id, ol_d_id, ol_o_id, ol_number),\n"
+         "	ADD INDEX fk_orderline_order (ol_w_id ASC, ol_d_id ASC, ol_o_id ASC),\n"
+         "	ADD INDEX fk_orderline_stock (ol_supply_w_id ASC, ol_i_id ASC)"},
+
+        {"ALTER TABLE tpcch.item ADD PRIMARY KEY (i_id)"},
+
+        {"ALTER TABLE tpcch.stock\n"
+         "	ADD PRIMARY KEY (s_w_id, s_i_id),\n"
+         "	ADD INDEX fk_stock_warehouse (s_w_id ASC),\n"
+         "	ADD INDEX fk_stock_item (s_i_id ASC)"},
+
+        {"ALTER TABLE tpcch.nation ADD PRIMARY KEY (n_nationkey)"},
+
+        {"ALTER TABLE tpcch.supplier ADD PRIMARY KEY (su_suppkey)"},
+
+        {"ALTER TABLE tpcch.region ADD PRIMARY KEY (r_regionkey)"}};
+
+    // Copies of the tables that the transactions modify, taken after the
+    // load, and the statements that reset the tables to them.
+    std::vector<const char*> dropSnapshotStatements = {
+        "DROP DATABASE IF EXISTS tpcch_snapshot"};
+
+    std::vector<const char*> snapshotStatements = {
+        "CREATE DATABASE tpcch_snapshot",
+        "CREATE TABLE tpcch_snapshot.warehouse AS SELECT * FROM tpcch.warehouse",
+        "CREATE TABLE tpcch_snapshot.district AS SELECT * FROM tpcch.district",
+        "CREATE TABLE tpcch_snapshot.customer AS SELECT * FROM tpcch.customer",
+        "CREATE TABLE tpcch_snapshot.history AS SELECT * FROM tpcch.history",
+        "CREATE TABLE tpcch_snapshot.neworder AS SELECT * FROM tpcch.neworder",
+        "CREATE TABLE tpcch_snapshot.order AS SELECT * FROM tpcch.order",
+        "CREATE TABLE tpcch_snapshot.orderline AS SELECT * FROM tpcch.orderline",
+        "CREATE TABLE tpcch_snapshot.stock AS SELECT * FROM tpcch.stock"};
+
+    std::vector<const char*> restoreStatements = {
+        "TRUNCATE TABLE tpcch.warehouse",
+        "TRUNCATE TABLE tpcch.district",
+        "TRUNCATE TABLE tpcch.customer",
+        "TRUNCATE TABLE tpcch.history",
+        "TRUNCATE TABLE tpcch.neworder",
+        "TRUNCATE TABLE tpcch.order",
+        "TRUNCATE TABLE tpcch.orderline",
+        "TRUNCATE TABLE tpcch.stock",
+        "INSERT INTO tpcch.warehouse SELECT * FROM tpcch_snapshot.warehouse",
+        "INSERT INTO tpcch.district SELECT * FROM tpcch_snapshot.district",
+        "INSERT INTO tpcch.customer SELECT * FROM tpcch_snapshot.customer",
+        "INSERT INTO tpcch.history SELECT * FROM tpcch_snapshot.history",
+        "INSERT INTO tpcch.neworder SELECT * FROM tpcch_snapshot.neworder",
+        "INSERT INTO tpcch.order SELECT * FROM tpcch_snapshot.order",
+        "INSERT INTO tpcch.orderline SELECT * FROM tpcch_snapshot.orderline",
+        "INSERT INTO tpcch.stock SELECT * FROM tpcch_snapshot.stock"};
+
+    // Read no rows, but fail if the table is missing.
+    std::vector<const char*> snapshotCheckStatements = {
+        "SELECT 1 FROM tpcch_snapshot.warehouse WHERE 1 = 0",
+        "SELECT 1 FROM tpcch_snapshot.district WHERE 1 = 0",
+        "SELECT 1 FROM tpcch_snapshot.customer WHERE 1 = 0",
+        "SELECT 1 FROM tpcch_snapshot.history WHERE 1 = 0",
+        "SELECT 1 FROM tpcch_snapshot.neworder WHERE 1 = 0",
+        "SELECT 1 FROM tpcch_snapshot.order WHERE 1 = 0",
+        "SELECT 1 FROM tpcch_snapshot.orderline WHERE 1 = 0",
+        "SELECT 1 FROM tpcch_snapshot.stock WHERE 1 = 0"};
+
     std::vector<const char*> additionalPreparationStatements = {};
 
     std::vector<const char*> importPrefixStrings = {
@@ -216,22 +278,53 @@ class MySqlDialect : public Dialect {
         "LOAD DATA INFILE '", "LOAD DATA INFILE '", "LOAD DATA INFILE '"};
 
     std::vector<const char*> importSuffixStrings = {
-        "/warehouse.tbl' INTO TABLE tpcch.warehouse FIELDS TERMINATED BY '|'",
-        "/district.tbl' INTO TABLE tpcch.district FIELDS TERMINATED BY '|'",
-        "/customer.tbl' INTO TABLE tpcch.customer FIELDS TERMINATED BY '|'",
-        "/history.tbl' INTO TABLE tpcch.history FIELDS TERMINATED BY '|'",
-        "/neworder.tbl' INTO TABLE tpcch.neworder FIELDS TERMINATED BY '|'",
-        "/order.tbl' INTO TABLE tpcch.order FIELDS TERMINATED BY '|' "
+        "' INTO TABLE tpcch.warehouse FIELDS TERMINATED BY '|'",
+        "' INTO TABLE tpcch.district FIELDS TERMINATED BY '|'",
+        "' INTO TABLE tpcch.customer FIELDS TERMINATED BY '|'",
+        "' INTO TABLE tpcch.history FIELDS TERMINATED BY '|'",
+        "' INTO TABLE tpcch.neworder FIELDS TERMINATED BY '|'",
+        "' INTO TABLE tpcch.order FIELDS TERMINATED BY '|' "
         "  (o_id, o_d_id, o_w_id, o_c_id, o_entry_d, @x, o_ol_cnt, o_all_local) "
         "  SET o_carrier_id = IF(@x = '', NULL, @x)",
-        "/orderline.tbl' INTO TABLE tpcch.orderline FIELDS TERMINATED BY '|'"
+        "' INTO TABLE tpcch.orderline FIELDS TERMINATED BY '|'"
         "  (ol_o_id, ol_d_id, ol_w_id, ol_number, ol_i_id, ol_supply_w_id, @x, ol_quantity, ol_amount, ol_dist_info) "
         "  SET ol_delivery_d = IF(@x = '', NULL, @x)",
-        "/item.tbl' INTO TABLE tpcch.item FIELDS TERMINATED BY '|'",
-        "/stock.tbl' INTO TABLE tpcch.stock FIELDS TERMINATED BY '|'",
-        "/nation.tbl' INTO TABLE tpcch.nation FIELDS TERMINATED BY '|'",
-        "/supplier.tbl' INTO TABLE tpcch.supplier FIELDS TERMINATED BY '|'",
-        "/region.tbl' INTO TABLE tpcch.region FIELDS TERMINATED BY '|'"};
+        "' INTO TABLE tpcch.item FIELDS TERMINATED BY '|'",
+        "' INTO TABLE tpcch.stock FIELDS TERMINATED BY '|'",
+        "' INTO TABLE tpcch.nation FIELDS TERMINATED BY '|'",
+        "' INTO TABLE tpcch.supplier FIELDS TERMINATED BY '|'",
+        "' INTO TABLE tpcch.region FIELDS TERMINATED BY '|'"};
+
+    std::vector<const char*> copyStrings = {};
+
+    std::vector<const char*> insertStrings = {
+        "INSERT INTO tpcch.warehouse VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO tpcch.district VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO tpcch.customer VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO tpcch.history VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO tpcch.neworder VALUES (?, ?, ?)",
+        "INSERT INTO tpcch.order VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO tpcch.orderline VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO tpcch.item VALUES (?, ?, ?, ?, ?)",
+        "INSERT INTO tpcch.stock VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO tpcch.nation VALUES (?, ?, ?, ?)",
+        "INSERT INTO tpcch.supplier VALUES (?, ?, ?, ?, ?, ?, ?)",
+        "INSERT INTO tpcch.region VALUES (?, ?, ?)"};
+
+    // Row count and checksum per table, see checksumField in Tables.h.
+    std::vector<const char*> checksumStrings = {
+        "select count(*), sum(w_id) from tpcch.warehouse",
+        "select count(*), sum(d_id) from tpcch.district",
+        "select count(*), sum(c_n_nationkey) from tpcch.customer",
+        "select count(*), sum(h_c_id) from tpcch.history",
+        "select count(*), sum(no_o_id) from tpcch.neworder",
+        "select count(*), sum(o_carrier_id) from tpcch.order",
+        "select count(*), sum(ol_i_id) from tpcch.orderline",
+        "select count(*), sum(i_im_id) from tpcch.item",
+        "select count(*), sum(s_quantity) from tpcch.stock",
+        "select count(*), sum(n_regionkey) from tpcch.nation",
+        "select count(*), sum(su_nationkey) from tpcch.supplier",
+        "select count(*), sum(r_regionkey) from tpcch.region"};
 
     std::vector<const char*> tpchQueryStrings = {
         // TPC-H-Query 1
@@ -752,6 +845,10 @@ class MySqlDialect : public Dialect {
         return createSchemaStatements;
     }
 
+    virtual std::vector<std::vector<const char*>>& getCreateIndexStatements() {
+        return createIndexStatements;
+    }
+
     virtual std::vector<const char*>& getImportPrefix() {
         return importPrefixStrings;
     }
@@ -760,6 +857,33 @@ class MySqlDialect : public Dialect {
         return importSuffixStrings;
     }
 
+    virtual std::vector<const char*>& getInsertStatements() {
+        return insertStrings;
+    }
+
+    virtual std::vector<const char*>& getCopyStatements() {
+        return copyStrings;
+    }
+
+    virtual std::vector<const char*>& getDropSnapshotStatements() {
+        return dropSnapshotStatements;
+    }
+
+    virtual std::vector<const char*>& getSnapshotStatements() {
+        return snapshotStatements;
+    }
+
+    virtual std::vector<const char*>& getRestoreStatements() {
+        return restoreStatements;
+    }
+
+    virtual std::vector<const char*>& getSnapshotCheckStatements() {
+        return snapshotCheckStatements;
+    }
+
+    // TRUNCATE commits implicitly.
+    virtual bool isRestoreTransactional() { return false; }
+
     virtual std::vector<const char*>& getAdditionalPreparationStatements() {
         return additionalPreparationStatements;
     }
@@ -774,6 +898,10 @@ class MySqlDialect : public Dialect {
         return "select count(*) from tpcch.warehouse";
     }
 
+    virtual const char* getSelectMaxWarehouse() {
+        return "select max(w_id) from tpcch.warehouse";
+    }
+
     virtual const char* getSelectCountDistrict() {
         return "select count(*) from tpcch.district";
     }
@@ -818,6 +946,63 @@ class MySqlDialect : public Dialect {
         return "select count(*) from tpcch.region";
     }
 
+    virtual std::vector<const char*>& getChecksumStatements() {
+        return checksumStrings;
+    }
+
+    virtual const char* getDeleteFingerprint() {
+        return "DELETE FROM tpcch.fingerprint";
+    }
+
+    virtual const char* getInsertFingerprintPrefix() {
+        return "INSERT INTO tpcch.fingerprint VALUES ('";
+    }
+
+    virtual const char* getSelectFingerprint() {
+        return "SELECT fp_digest FROM tpcch.fingerprint";
+    }
+
+    virtual const char* getInsertProgressPrefix() {
+        return "INSERT INTO tpcch.load_progress VALUES ('";
+    }
+
+    virtual const char* getSelectProgressPrefix() {
+        return "SELECT count(*), min(lp_rows), max(lp_rows)\n"
+               "FROM tpcch.load_progress WHERE lp_file = '";
+    }
+
+    virtual const char* getDeleteProgress() {
+        return "DELETE FROM tpcch.load_progress";
+    }
+
+    virtual std::vector<std::string>
+    getPartitionStatements(Table t, const std::vector<int>& lastWarehouses) {
+        std::string stmt = std::string("ALTER TABLE tpcch.") + tableName(t) +
+                           " PARTITION BY RANGE (" + warehouseColumnName(t) + ") (";
+        for (size_t p = 0; p < lastWarehouses.size(); p++) {
+            stmt += p ? ",\n\tPARTITION p" : "\n\tPARTITION p";
+            stmt += std::to_string(p) + " VALUES LESS THAN ";
+            stmt += p + 1 < lastWarehouses.size()
+                        ? "(" + std::to_string(lastWarehouses[p] + 1) + ")"
+                        : "MAXVALUE";
+        }
+        return {stmt + ")"};
+    }
+
+    virtual std::string getPartitionImportPrefix(Table t, int) {
+        return importPrefixStrings[static_cast<int>(t)];
+    }
+
+    // LOAD DATA names the partition right after the table.
+    virtual std::string getPartitionImportSuffix(Table t, int p) {
+        std::string suffix = importSuffixStrings[static_cast<int>(t)];
+        std::string table = std::string("tpcch.") + tableName(t);
+        return suffix.insert(suffix.find(table) + table.size(),
+                             " PARTITION (p" + std::to_string(p) + ")");
+    }
+
+    virtual std::string getPartitionCopyStatement(Table, int) { return ""; }
+
     // TPC-C transaction strings
     // NewOrder:
     virtual const char* getNoWarehouseSelect() {
@@ -42,12 +42,14 @@ const mz::Config& mz::defaultConfig() {
         .kafkaUrl = "kafka://kafka:9092",
         .schemaRegistryUrl = "http://schema-registry:8081",
         .hQueries = {},
+        .allQueries = {},
         .dialect = new MySqlDialect(),
         .hist_date_offset_millis = zero_const,
         .order_entry_date_offset_millis = zero_const,
         .orderline_delivery_date_offset_millis = zero_const,
         .payment_amount_cents = static_cast<inner_type>(std::uniform_int_distribution<int64_t>(100, 500000)),
         .item_price_cents = static_cast<inner_type>(std::uniform_int_distribution<int64_t>(100, 10000)),
+        .phases = {},
     };
     return singleton;
 }
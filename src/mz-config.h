@@ -16,6 +16,8 @@ limitations under the License.
 
 #pragma once
 
+#include <array>
+#include <optional>
 #include <unordered_set>
 #include <string>
 #include <unordered_map>
@@ -27,6 +29,20 @@ limitations under the License.
 
 namespace mz {
 
+// A phase of the load schedule in the config file's phases list. What a
+// phase leaves out is as given on the command line.
+struct Phase {
+    std::string name;
+    int seconds;
+    // how many of the threads are active during the phase
+    std::optional<int> transactionalThreads;
+    std::optional<int> analyticThreads;
+    std::optional<double> targetTpm;
+    std::optional<double> targetQph;
+    // weights of NewOrder, Payment, OrderStatus, Delivery and StockLevel
+    std::optional<std::array<int, 5>> mix;
+};
+
 struct Config {
     std::unordered_set<std::string> expectedSources;
     std::string viewPattern;
@@ -41,6 +57,7 @@ struct Config {
     chRandom::int_distribution orderline_delivery_date_offset_millis;
     chRandom::int_distribution payment_amount_cents;
     chRandom::int_distribution item_price_cents;
+    std::vector<Phase> phases;
 };
 
 const Config& defaultConfig(); // The config that works with our current docker-compose setup